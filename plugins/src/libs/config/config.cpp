@@ -341,6 +341,47 @@ namespace gazebo_rcll {
  *
  */
 
+/** Constructor. */
+Configuration::Configuration()
+  : generation_(0)
+{
+}
+
+
+/** Get configuration generation.
+ * The generation is increased on every change of the configuration values.
+ * @return current generation
+ */
+unsigned int
+Configuration::generation() const
+{
+  return generation_;
+}
+
+
+/** Notify about changed values.
+ * Implementations must call this whenever values have been loaded, set or
+ * erased. It increases the generation, invalidating all cached values of
+ * ConfigValueHandle instances bound to this configuration.
+ */
+void
+Configuration::values_changed()
+{
+  ++generation_;
+}
+
+
+/** @class ConfigValueHandle <config/config.h>
+ * Typed handle to a single configuration value.
+ * The handle resolves its path once and afterwards returns the cached value,
+ * avoiding the path split and tree walk of Configuration::get_float() and
+ * friends in code that runs every simulation step. The cached value is
+ * dropped when the configuration it is bound to changes.
+ * Supported types are float, unsigned int, int, bool and std::string.
+ * The handle must not outlive the configuration it is bound to.
+ */
+
+
 /** @class ConfigurationException config/config.h
  * Generic configuration exception.
  * Thrown if there is no other matching exception.
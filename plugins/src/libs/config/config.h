@@ -26,6 +26,7 @@
 
 #include <core/exception.h>
 #include <utils/misc/string_compare.h>
+#include <atomic>
 #include <string>
 #include <list>
 #include <map>
@@ -62,8 +63,11 @@ class CouldNotOpenConfigException : public fawkes::Exception
 class Configuration
 {
  public:
+  Configuration();
   virtual ~Configuration() {}
 
+  unsigned int          generation() const;
+
   class ValueIterator
   {
    public:
@@ -174,6 +178,57 @@ class Configuration
 
   virtual void            try_dump()                                      = 0;
 
+ protected:
+  void                    values_changed();
+
+ private:
+  std::atomic<unsigned int> generation_;
+};
+
+
+template <typename T>
+class ConfigValueHandle
+{
+ public:
+  /** Constructor.
+   * @param config configuration to read the value from
+   * @param path path to value
+   */
+  ConfigValueHandle(Configuration *config, const char *path)
+    : config_(config), path_(path), generation_(0), resolved_(false) {}
+
+  /** Get value.
+   * The path is looked up on the first call and whenever the configuration
+   * reports a change, all other calls return the cached value.
+   * @return value
+   */
+  inline const T & get()
+  {
+    if (! resolved_ || generation_ != config_->generation()) {
+      generation_ = config_->generation();
+      fetch(value_);
+      resolved_ = true;
+    }
+    return value_;
+  }
+
+  /** Get path.
+   * @return path to value
+   */
+  const char * path() const { return path_.c_str(); }
+
+ private:
+  void fetch(float &v)        { v = config_->get_float(path_.c_str()); }
+  void fetch(unsigned int &v) { v = config_->get_uint(path_.c_str()); }
+  void fetch(int &v)          { v = config_->get_int(path_.c_str()); }
+  void fetch(bool &v)         { v = config_->get_bool(path_.c_str()); }
+  void fetch(std::string &v)  { v = config_->get_string(path_.c_str()); }
+
+  Configuration *config_;
+  std::string    path_;
+  unsigned int   generation_;
+  bool           resolved_;
+  T              value_;
 };
 
 } // end namespace gazebo_rcll
@@ -0,0 +1,114 @@
+
+/***************************************************************************
+ *  qa_config_handle.cpp - config value handle lookup benchmark
+ *
+ *  Created: Sat Oct 17 11:35:32 2026
+ *  Copyright  2026  agent
+ *
+ ****************************************************************************/
+
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.GPL file in the doc directory.
+ */
+
+// Do not mention in API doc
+/// @cond QA
+
+#include <config/yaml.h>
+
+#include <sys/time.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace gazebo_rcll;
+
+static double
+now()
+{
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec + tv.tv_usec / 1000000.;
+}
+
+static void
+write_value(const char *file, float value)
+{
+  FILE *f = fopen(file, "w");
+  fprintf(f, "%%YAML 1.2\n---\nvalue: %f\n", value);
+  fclose(f);
+}
+
+// a handle must return the new value after the configuration was reloaded,
+// and the reload must report the changed path
+static bool
+test_reload()
+{
+  char file[] = "/tmp/qa_config_handle_XXXXXX";
+  int fd = mkstemp(file);
+  if (fd == -1)  return false;
+  close(fd);
+
+  write_value(file, 1.0);
+  YamlConfiguration config;
+  config.load(file);
+  ConfigValueHandle<float> value(&config, "value");
+  float before = value.get();
+
+  write_value(file, 2.0);
+  std::list<std::string> changes = config.reload();
+  float after = value.get();
+  unlink(file);
+
+  printf("Handle after reload: %f -> %f\n", before, after);
+  for (std::list<std::string>::iterator c = changes.begin(); c != changes.end(); ++c) {
+    printf("Changed on reload: %s\n", c->c_str());
+  }
+  return before == 1.0 && after == 2.0 && changes.size() == 1;
+}
+
+int
+main(int argc, char **argv)
+{
+  unsigned int num_lookups = 1000000;
+  if (argc > 1)  num_lookups = atoi(argv[1]);
+
+  YamlConfiguration config(CONFDIR);
+  config.load("config.yaml");
+
+  volatile float sum = 0.;
+
+  double start = now();
+  for (unsigned int i = 0; i < num_lookups; ++i) {
+    sum += config.get_float("plugins/puck/ring_height");
+  }
+  double path_time = now() - start;
+
+  ConfigValueHandle<float> ring_height(&config, "plugins/puck/ring_height");
+  start = now();
+  for (unsigned int i = 0; i < num_lookups; ++i) {
+    sum += ring_height.get();
+  }
+  double handle_time = now() - start;
+
+  printf("%u lookups of plugins/puck/ring_height (checksum %f)\n", num_lookups, sum);
+  printf("  get_float():  %14.0f lookups/s\n", num_lookups / path_time);
+  printf("  handle get(): %14.0f lookups/s\n", num_lookups / handle_time);
+
+  if (! test_reload()) {
+    printf("Handle kept a stale value after reload\n");
+    return 1;
+  }
+  return 0;
+}
+
+/// @endcond
@@ -26,6 +26,7 @@
 #include "yaml_node.h"
 
 #include <core/threading/mutex.h>
+#include <core/threading/mutex_locker.h>
 #include <core/exceptions/software.h>
 // include <logging/liblogger.h>
 #ifdef HAVE_FAM
@@ -456,6 +457,7 @@ YamlConfiguration::load(const char *file_path)
   host_file_ = "";
   std::list<std::string> files, dirs;
   read_yaml_config(filename, host_file_, root_, host_root_, files, dirs);
+  values_changed();
 
 #ifdef HAVE_FAM
   fam_thread_ = new FamThread();
@@ -594,31 +596,65 @@ YamlConfiguration::read_yaml_config(std::string filename, std::string &host_file
 }
 
 
+/** Reload the configuration.
+ * Reads the file given to load() and its includes again. If any value
+ * changed, the values are replaced and cached values of ConfigValueHandle
+ * instances are fetched again on their next use.
+ * @return paths of the values which were added, changed or removed
+ * @exception Exception thrown if the files cannot be read, the current
+ * values are kept in that case
+ */
+std::list<std::string>
+YamlConfiguration::reload()
+{
+  std::list<std::string> files, dirs;
+  return reload(files, dirs);
+}
+
+
+/** Reload the configuration.
+ * @param files upon return contains the files that have been read
+ * @param dirs upon return contains the directories that have been read
+ * @return paths of the values which were added, changed or removed
+ */
+std::list<std::string>
+YamlConfiguration::reload(std::list<std::string> &files, std::list<std::string> &dirs)
+{
+  fawkes::MutexLocker lock(mutex);
+  std::string host_file = "";
+  YamlConfigurationNode *root, *host_root;
+  read_yaml_config(config_file_, host_file, root, host_root, files, dirs);
+
+  std::list<std::string> changes = YamlConfigurationNode::diff(root_, root);
+
+  if (! changes.empty()) {
+    YamlConfigurationNode *old_root = root_;
+    YamlConfigurationNode *old_host_root = host_root_;
+    root_ = root;
+    host_root_ = host_root;
+    host_file_ = host_file;
+    delete old_root;
+    delete old_host_root;
+    values_changed();
+  } else {
+    delete root;
+    delete host_root;
+  }
+  return changes;
+}
+
+
 #ifdef HAVE_FAM
 void
 YamlConfiguration::fam_event(const char *filename, unsigned int mask)
 {
   try {
-    std::string host_file = "";
     std::list<std::string> files, dirs;
-    YamlConfigurationNode *root, *host_root;
-    read_yaml_config(config_file_, host_file, root, host_root, files, dirs);
-
-    std::list<std::string> changes = YamlConfigurationNode::diff(root_, root);
-
-    if (! changes.empty()) {
-      YamlConfigurationNode *old_root = root_;
-      YamlConfigurationNode *old_host_root = host_root_;
-      root_ = root;
-      host_root_ = host_root;
-      host_file_ = host_file;
-      delete old_root;
-      delete old_host_root;
-
-      std::list<std::string>::iterator c;
-      for (c = changes.begin(); c != changes.end(); ++c) {
-        notify_handlers(c->c_str());
-      }
+    std::list<std::string> changes = reload(files, dirs);
+
+    std::list<std::string>::iterator c;
+    for (c = changes.begin(); c != changes.end(); ++c) {
+      notify_handlers(c->c_str());
     }
 
     // includes might have changed to include a new empty file
@@ -1120,6 +1156,7 @@ YamlConfiguration::set_float(const char *path, float f)
 {
   root_->set_value(path, f);
   host_root_->set_value(path, f);
+  values_changed();
   write_host_file();
 }
 
@@ -1128,6 +1165,7 @@ YamlConfiguration::set_uint(const char *path, unsigned int uint)
 {
   root_->set_value(path, uint);
   host_root_->set_value(path, uint);
+  values_changed();
   write_host_file();
 }
 
@@ -1136,6 +1174,7 @@ YamlConfiguration::set_int(const char *path, int i)
 {
   root_->set_value(path, i);
   host_root_->set_value(path, i);
+  values_changed();
   write_host_file();
 }
 
@@ -1144,6 +1183,7 @@ YamlConfiguration::set_bool(const char *path, bool b)
 {
   root_->set_value(path, b);
   host_root_->set_value(path, b);
+  values_changed();
   write_host_file();
 }
 
@@ -1152,6 +1192,7 @@ YamlConfiguration::set_string(const char *path, const char *s)
 {
   root_->set_value(path, std::string(s));
   host_root_->set_value(path, std::string(s));
+  values_changed();
   write_host_file();
 }
 
@@ -1167,6 +1208,7 @@ YamlConfiguration::set_floats(const char *path, std::vector<float> &f)
 {
   root_->set_list(path, f);
   host_root_->set_list(path, f);
+  values_changed();
   write_host_file();
 }
 
@@ -1175,6 +1217,7 @@ YamlConfiguration::set_uints(const char *path, std::vector<unsigned int> &u)
 {
   root_->set_list(path, u);
   host_root_->set_list(path, u);
+  values_changed();
   write_host_file();
 }
 
@@ -1183,6 +1226,7 @@ YamlConfiguration::set_ints(const char *path, std::vector<int> &i)
 {
   root_->set_list(path, i);
   host_root_->set_list(path, i);
+  values_changed();
   write_host_file();
 }
 
@@ -1191,6 +1235,7 @@ YamlConfiguration::set_bools(const char *path, std::vector<bool> &b)
 {
   root_->set_list(path, b);
   host_root_->set_list(path, b);
+  values_changed();
   write_host_file();
 }
 
@@ -1199,6 +1244,7 @@ YamlConfiguration::set_strings(const char *path, std::vector<std::string> &s)
 {
   root_->set_list(path, s);
   host_root_->set_list(path, s);
+  values_changed();
   write_host_file();
 }
 
@@ -1207,6 +1253,7 @@ YamlConfiguration::set_strings(const char *path, std::vector<const char *> &s)
 {
   root_->set_list(path, s);
   host_root_->set_list(path, s);
+  values_changed();
   write_host_file();
 }
 
@@ -1225,6 +1272,7 @@ YamlConfiguration::erase(const char *path)
 {
   host_root_->erase(path);
   root_->erase(path);
+  values_changed();
   write_host_file();
 }
 
@@ -61,6 +61,7 @@ class YamlConfiguration
   virtual void          copy(Configuration *copyconf);
 
   virtual void          load(const char *file_path);
+  std::list<std::string> reload();
 
   virtual bool          exists(const char *path);
   virtual bool          is_float(const char *path);
@@ -194,6 +195,8 @@ class YamlConfiguration
   void read_yaml_config(std::string filename, std::string &host_file,
                         YamlConfigurationNode *& root, YamlConfigurationNode *& host_root,
                         std::list<std::string> &files, std::list<std::string> &dirs);
+  std::list<std::string> reload(std::list<std::string> &files,
+                                std::list<std::string> &dirs);
   void write_host_file();
 
   std::string config_file_;
@@ -23,29 +23,82 @@
 
 #include "configurable.h"
 
+#include <core/threading/mutex.h>
+#include <core/threading/mutex_locker.h>
+
 namespace gazebo_rcll {
 #if 0 /* just to make Emacs auto-indent happy */
 }
 #endif
 
+/** @class ConfigurableAspect <configurable/configurable.h>
+ * Aspect providing read access to the simulation configuration.
+ * All aspects in the process share one configuration snapshot which
+ * is parsed from config.yaml when the first aspect is created. Since
+ * every workpiece, MPS and most sensors are configurable, this avoids
+ * re-parsing the YAML file for each of them during world load and
+ * whenever a new workpiece is spawned.
+ * The snapshot is reference counted and never reloaded, the readers
+ * of the shared configuration are not synchronized with each other.
+ * @author Frederik Zwilling
+ */
+
 /** @var Configuration *  Configurable::config
  * This is the Configuration member used to access the configuration.
  * The configuration will remain valid for the whole lifetime of the
- * thread.
+ * thread. It is shared with all other aspects and must be treated as
+ * read-only.
  */
 
+/// @cond INTERNALS
+static fawkes::Mutex &
+shared_config_mutex()
+{
+  static fawkes::Mutex mutex;
+  return mutex;
+}
+
+static fawkes::RefPtr<YamlConfiguration> &
+shared_config()
+{
+  static fawkes::RefPtr<YamlConfiguration> config;
+  return config;
+}
+
+static fawkes::RefPtr<YamlConfiguration>
+load_config()
+{
+  YamlConfiguration *config = new YamlConfiguration(CONFDIR);
+  try {
+    config->load("config.yaml");
+  } catch (fawkes::Exception &e) {
+    delete config;
+    throw;
+  }
+  return fawkes::RefPtr<YamlConfiguration>(config);
+}
+/// @endcond
+
 /** Constructor.
- Initializes the configuration*/
+ * Attaches to the shared configuration snapshot, loading it if this
+ * is the first aspect in the process. */
 ConfigurableAspect::ConfigurableAspect()
 {
-  this->config = new YamlConfiguration(CONFDIR);
-  this->config->load("config.yaml");
+  fawkes::MutexLocker lock(&shared_config_mutex());
+  if (! shared_config()) {
+    shared_config() = load_config();
+  }
+  config_snapshot_ = shared_config();
+  this->config = *config_snapshot_;
 }
 
-/** Virtual empty Destructor. */
+/** Destructor.
+ * Releases this aspect's reference to the configuration snapshot. */
 ConfigurableAspect::~ConfigurableAspect()
 {
-  delete this->config;
+  fawkes::MutexLocker lock(&shared_config_mutex());
+  this->config = NULL;
+  config_snapshot_.reset();
 }
 
 } // end namespace fawkes
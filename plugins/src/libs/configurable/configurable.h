@@ -24,6 +24,7 @@
 #define __ASPECT_CONFIGURABLE_H_
 
 #include <config/yaml.h>
+#include <core/utils/refptr.h>
 
 namespace gazebo_rcll {
 #if 0 /* just to make Emacs auto-indent happy */
@@ -38,6 +39,9 @@ class ConfigurableAspect
 
  protected:
   Configuration *config;
+
+ private:
+  fawkes::RefPtr<YamlConfiguration> config_snapshot_;
 };
 
 } // end namespace fawkes
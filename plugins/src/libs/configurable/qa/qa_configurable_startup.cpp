@@ -0,0 +1,107 @@
+
+/***************************************************************************
+ *  qa_configurable_startup.cpp - configurable aspect startup benchmark
+ *
+ *  Created: Sat Oct 17 11:34:04 2026
+ *  Copyright  2026  agent
+ *
+ ****************************************************************************/
+
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.GPL file in the doc directory.
+ */
+
+// Do not mention in API doc
+/// @cond QA
+
+#include <configurable/configurable.h>
+
+#include <sys/time.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace gazebo_rcll;
+
+class BenchmarkAspect : public ConfigurableAspect
+{
+ public:
+  float belt_length() { return config->get_float("plugins/mps/belt_length"); }
+};
+
+static double
+now()
+{
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec + tv.tv_usec / 1000000.;
+}
+
+static long
+rss_kb()
+{
+  long pages = 0, resident = 0;
+  FILE *f = fopen("/proc/self/statm", "r");
+  if (f) {
+    if (fscanf(f, "%ld %ld", &pages, &resident) != 2)  resident = 0;
+    fclose(f);
+  }
+  return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+int
+main(int argc, char **argv)
+{
+  // 40 workpieces, 12 MPS and a handful of robot sensors by default
+  unsigned int num_aspects = 60;
+  if (argc > 1)  num_aspects = atoi(argv[1]);
+
+  float sum = 0.;
+
+  // shared snapshot, as used by ConfigurableAspect
+  long rss_start = rss_kb();
+  double start = now();
+  std::vector<BenchmarkAspect *> aspects;
+  for (unsigned int i = 0; i < num_aspects; ++i) {
+    aspects.push_back(new BenchmarkAspect());
+    sum += aspects.back()->belt_length();
+  }
+  double shared_time = now() - start;
+  long shared_rss = rss_kb() - rss_start;
+
+  // one parsed configuration per aspect, as done before
+  rss_start = rss_kb();
+  start = now();
+  std::vector<Configuration *> configs;
+  for (unsigned int i = 0; i < num_aspects; ++i) {
+    YamlConfiguration *c = new YamlConfiguration(CONFDIR);
+    c->load("config.yaml");
+    configs.push_back(c);
+    sum += c->get_float("plugins/mps/belt_length");
+  }
+  double private_time = now() - start;
+  long private_rss = rss_kb() - rss_start;
+
+  printf("Loading configuration for %u aspects (checksum %f)\n", num_aspects, sum);
+  printf("  per-aspect parse:  %8.3f ms  %6ld KB RSS\n", private_time * 1000., private_rss);
+  printf("  shared snapshot:   %8.3f ms  %6ld KB RSS\n", shared_time * 1000., shared_rss);
+
+  for (unsigned int i = 0; i < num_aspects; ++i) {
+    delete configs[i];
+    delete aspects[i];
+  }
+
+  return 0;
+}
+
+/// @endcond
@@ -60,6 +60,7 @@ ProtobufStreamClient::ProtobufStreamClient()
   message_register_ = new MessageRegister();
   own_message_register_ = true;
   connected_ = false;
+  arena_parsing_ = false;
   outbound_active_ = false;
   in_data_size_ = 1024;
   frame_header_version_ = PB_FRAME_V2;
@@ -80,6 +81,7 @@ ProtobufStreamClient::ProtobufStreamClient(std::vector<std::string> &proto_path)
   message_register_ = new MessageRegister(proto_path);
   own_message_register_ = true;
   connected_ = false;
+  arena_parsing_ = false;
   outbound_active_ = false;
   in_data_size_ = 1024;
   in_data_ = malloc(in_data_size_);
@@ -101,6 +103,7 @@ ProtobufStreamClient::ProtobufStreamClient(MessageRegister *mr,
     frame_header_version_(header_version)
 {
   connected_ = false;
+  arena_parsing_ = false;
   outbound_active_ = false;
   in_data_size_ = 1024;
   in_data_ = malloc(in_data_size_);
@@ -301,7 +304,7 @@ ProtobufStreamClient::handle_read_message(const boost::system::error_code& error
     uint16_t msg_type  = ntohs(message_header.msg_type);
     try {
       std::shared_ptr<google::protobuf::Message> m =
-	message_register_->deserialize(frame_header, message_header, data);
+	message_register_->deserialize(frame_header, message_header, data, arena_parsing_);
 
       sig_rcvd_(comp_id, msg_type, m);
     } catch (std::runtime_error &e) {
@@ -315,23 +318,30 @@ ProtobufStreamClient::handle_read_message(const boost::system::error_code& error
   }
 }
 
+/** Write all queued messages with one gathered write.
+ * The outbound mutex must be held and the queue must not be empty.
+ */
+void
+ProtobufStreamClient::start_write()
+{
+  outbound_active_ = true;
+  outbound_batch_.gather(outbound_queue_);
+  boost::asio::async_write(socket_, outbound_batch_.buffers(),
+			   boost::bind(&ProtobufStreamClient::handle_write, this,
+				       boost::asio::placeholders::error,
+				       boost::asio::placeholders::bytes_transferred));
+}
+
 void
 ProtobufStreamClient::handle_write(const boost::system::error_code& error,
-				   size_t /*bytes_transferred*/,
-				   QueueEntry *entry)
+				   size_t /*bytes_transferred*/)
 {
-  delete entry;
+  outbound_batch_.release(outbound_pool_);
 
   if (! error) {
     std::lock_guard<std::mutex> lock(outbound_mutex_);
     if (! outbound_queue_.empty()) {
-      QueueEntry *entry = outbound_queue_.front();
-      outbound_queue_.pop();
-      boost::asio::async_write(socket_, entry->buffers,
-			       boost::bind(&ProtobufStreamClient::handle_write, this,
-					   boost::asio::placeholders::error,
-					   boost::asio::placeholders::bytes_transferred,
-					   entry));
+      start_write();
     } else {
       outbound_active_ = false;
     }
@@ -355,10 +365,15 @@ ProtobufStreamClient::send(uint16_t component_id, uint16_t msg_type,
     throw std::runtime_error("Cannot send while not connected");
   }
 
-  QueueEntry *entry = new QueueEntry();
-  message_register_->serialize(component_id, msg_type, m,
-			       entry->frame_header, entry->message_header,
-			       entry->serialized_message);
+  QueueEntry *entry = outbound_pool_.acquire();
+  try {
+    message_register_->serialize(component_id, msg_type, m,
+				 entry->frame_header, entry->message_header,
+				 entry->serialized_message);
+  } catch (std::runtime_error &e) {
+    outbound_pool_.release(entry);
+    throw;
+  }
 
   if (frame_header_version_ == PB_FRAME_V1) {
     entry->frame_header_v1.component_id = entry->message_header.component_id;
@@ -375,15 +390,9 @@ ProtobufStreamClient::send(uint16_t component_id, uint16_t msg_type,
   entry->buffers[2] = boost::asio::buffer(entry->serialized_message);
  
   std::lock_guard<std::mutex> lock(outbound_mutex_);
-  if (outbound_active_) {
-    outbound_queue_.push(entry);
-  } else {
-    outbound_active_ = true;
-    boost::asio::async_write(socket_, entry->buffers,
-			     boost::bind(&ProtobufStreamClient::handle_write, this,
-					 boost::asio::placeholders::error,
-					 boost::asio::placeholders::bytes_transferred,
-					 entry));
+  outbound_queue_.push(entry);
+  if (! outbound_active_) {
+    start_write();
   }
 }
 
@@ -430,4 +439,21 @@ ProtobufStreamClient::send(std::shared_ptr<google::protobuf::Message> m)
   send(*m);
 }
 
+
+/** Enable or disable parsing received messages into arenas.
+ * When enabled, each received message and its sub-messages are allocated
+ * in one protobuf arena that is freed with the last reference to the
+ * message, instead of allocating every sub-message and string on its
+ * own. This pays off for messages with many sub-messages like the
+ * MachineInfo, small flat messages are created faster on the heap.
+ * Must be set before messages are received.
+ * @param enabled true to parse into arenas, false to allocate messages
+ * on the heap (the default)
+ */
+void
+ProtobufStreamClient::set_arena_parsing(bool enabled)
+{
+  arena_parsing_ = enabled;
+}
+
 } // end namespace protobuf_comm
@@ -85,6 +85,8 @@ class ProtobufStreamClient
   void send(std::shared_ptr<google::protobuf::Message> m);
   void send(google::protobuf::Message &m);
 
+  void set_arena_parsing(bool enabled);
+
   /** Signal that is invoked when a message has been received.
    * @return signal
    */
@@ -118,8 +120,9 @@ class ProtobufStreamClient
   void handle_resolve(const boost::system::error_code& err,
 		      boost::asio::ip::tcp::resolver::iterator endpoint_iterator);
   void handle_connect(const boost::system::error_code& err);
+  void start_write();
   void handle_write(const boost::system::error_code& error,
-		    size_t /*bytes_transferred*/, QueueEntry *entry);
+		    size_t /*bytes_transferred*/);
   void start_recv();
   void handle_read_header(const boost::system::error_code& error);
   void handle_read_message(const boost::system::error_code& error);
@@ -143,6 +146,8 @@ class ProtobufStreamClient
   std::queue<QueueEntry *> outbound_queue_;
   std::mutex               outbound_mutex_;
   bool                     outbound_active_;
+  QueueEntryPool           outbound_pool_;
+  QueueEntryBatch          outbound_batch_;
 
   void   *in_frame_header_;
   size_t  in_frame_header_size_;
@@ -151,6 +156,7 @@ class ProtobufStreamClient
 
   MessageRegister *message_register_;
   bool             own_message_register_;
+  bool             arena_parsing_;
 
   frame_header_version_t frame_header_version_;
 };
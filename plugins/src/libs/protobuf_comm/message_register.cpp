@@ -38,6 +38,10 @@
 
 #include <google/protobuf/compiler/importer.h>
 #include <google/protobuf/dynamic_message.h>
+#if GOOGLE_PROTOBUF_VERSION >= 3000000
+#  include <google/protobuf/arena.h>
+#endif
+#include <algorithm>
 #include <netinet/in.h>
 #include <sys/types.h>
 #include <dirent.h>
@@ -54,11 +58,16 @@ namespace protobuf_comm {
  * The register is used to automatically parse incoming messages to the
  * appropriate type. In your application, you need to register any
  * message you want to read. All unknown messages are silently dropped.
+ *
+ * Once all types are registered, call freeze(). Message types of incoming
+ * messages are then looked up without locking. Types can still be added
+ * or removed afterwards, but each change copies the lookup table.
  * @author Tim Niemueller
  */
 
 /** Constructor. */
 MessageRegister::MessageRegister()
+  : frozen_(false), type_table_(NULL)
 {
   pb_srctree_  = NULL;
   pb_importer_ = NULL;
@@ -72,6 +81,7 @@ MessageRegister::MessageRegister()
  * message creation.
  */
 MessageRegister::MessageRegister(std::vector<std::string> &proto_path)
+  : frozen_(false), type_table_(NULL)
 {
   pb_srctree_ = new google::protobuf::compiler::DiskSourceTree();
   for (size_t i = 0; i < proto_path.size(); ++i) {
@@ -106,6 +116,8 @@ MessageRegister::MessageRegister(std::vector<std::string> &proto_path)
       closedir (dir);
     }
   }
+
+  freeze();
 }
 
 /** Destructor. */
@@ -115,6 +127,13 @@ MessageRegister::~MessageRegister()
   for (m = message_by_comp_type_.begin(); m != message_by_comp_type_.end(); ++m) {
     delete m->second;
   }
+  delete type_table_.load();
+  for (const TypeTable *t : retired_type_tables_) {
+    delete t;
+  }
+  for (google::protobuf::Message *m : removed_types_) {
+    delete m;
+  }
   delete pb_factory_;
   delete pb_importer_;
   delete pb_srctree_;
@@ -172,6 +191,7 @@ MessageRegister::add_message_type(std::string msg_type)
     //printf("Registering %s (%u:%u)\n", msg_type.c_str(), key.first, key.second);
     message_by_comp_type_[key] = m;
     message_by_typename_[m->GetTypeName()] = m;
+    publish_type_table();
   } else {
     throw std::runtime_error("Unknown message type");
   }
@@ -188,12 +208,55 @@ MessageRegister::remove_message_type(uint16_t component_id, uint16_t msg_type)
   KeyType key(component_id, msg_type);
   std::lock_guard<std::mutex> lock(maps_mutex_);
   if (message_by_comp_type_.find(key) != message_by_comp_type_.end()) {
+    removed_types_.push_back(message_by_comp_type_[key]);
     message_by_typename_.erase(message_by_comp_type_[key]->GetDescriptor()->full_name());
     message_by_comp_type_.erase(key);
+    publish_type_table();
   }
 }
 
 
+/** Freeze the registered message types.
+ * Publishes a flat table of the currently registered types, from which
+ * the types of received messages are looked up without locking. Call
+ * this after registering all types. The register is frozen already after
+ * construction with a proto path.
+ */
+void
+MessageRegister::freeze()
+{
+  std::lock_guard<std::mutex> lock(maps_mutex_);
+  frozen_ = true;
+  publish_type_table();
+}
+
+
+/** Publish the current types for lookups without locking.
+ * Must be called with maps_mutex_ held after each change of
+ * message_by_comp_type_, does nothing until the register is frozen.
+ * The previous table is kept until destruction, because a reader might
+ * still use it.
+ */
+void
+MessageRegister::publish_type_table()
+{
+  if (! frozen_)  return;
+
+  // the map is ordered by component ID, then message type, like the keys
+  TypeTable *table = new TypeTable();
+  table->reserve(message_by_comp_type_.size());
+  for (TypeMap::const_iterator t = message_by_comp_type_.begin();
+       t != message_by_comp_type_.end(); ++t)
+  {
+    table->push_back(std::make_pair((uint32_t)t->first.first << 16 | t->first.second,
+				    t->second));
+  }
+
+  const TypeTable *old_table = type_table_.exchange(table, std::memory_order_acq_rel);
+  if (old_table)  retired_type_tables_.push_back(old_table);
+}
+
+
 MessageRegister::KeyType
 MessageRegister::key_from_desc(const google::protobuf::Descriptor *desc)
 {
@@ -228,22 +291,42 @@ MessageRegister::key_from_desc(const google::protobuf::Descriptor *desc)
 std::shared_ptr<google::protobuf::Message>
 MessageRegister::new_message_for(uint16_t component_id, uint16_t msg_type)
 {
-  KeyType key(component_id, msg_type);
+  return std::shared_ptr<google::protobuf::Message>(prototype_for(component_id, msg_type)->New());
+}
+
+
+/** Get the registered message instance of a type.
+ * Once frozen, types are looked up without locking in the last published
+ * table, before that in the map of registered types.
+ * @param component_id ID of component this message type belongs to
+ * @param msg_type message type
+ * @return message instance to create new messages from
+ * @exception std::runtime_error thrown if the type is not registered
+ */
+const google::protobuf::Message *
+MessageRegister::prototype_for(uint16_t component_id, uint16_t msg_type)
+{
+  const TypeTable *types = type_table_.load(std::memory_order_acquire);
+  if (types) {
+    uint32_t key = (uint32_t)component_id << 16 | msg_type;
+    TypeTable::const_iterator t =
+      std::lower_bound(types->begin(), types->end(), key,
+		       [](const TypeTable::value_type &e, uint32_t k) { return e.first < k; });
+    if (t != types->end() && t->first == key)  return t->second;
+  } else {
+    std::lock_guard<std::mutex> lock(maps_mutex_);
+    TypeMap::const_iterator t = message_by_comp_type_.find(KeyType(component_id, msg_type));
+    if (t != message_by_comp_type_.end())  return t->second;
+  }
 
-  std::lock_guard<std::mutex> lock(maps_mutex_);
-  if (message_by_comp_type_.find(key) == message_by_comp_type_.end()) {
 #if defined(__GNUC__) && (__GNUC__ < 4 || (__GNUC__ == 4 && __GNUC_MINOR__ < 6))
-    std::string msg = "Message type " + std::to_string((long long)component_id) + ":" +
-      std::to_string((long long)msg_type) + " not registered";
+  std::string msg = "Message type " + std::to_string((long long)component_id) + ":" +
+    std::to_string((long long)msg_type) + " not registered";
 #else
-    std::string msg = "Message type " + std::to_string(component_id) + ":" +
-      std::to_string(msg_type) + " not registered";
+  std::string msg = "Message type " + std::to_string(component_id) + ":" +
+    std::to_string(msg_type) + " not registered";
 #endif
-    throw std::runtime_error(msg);
-  }
-
-  google::protobuf::Message *m = message_by_comp_type_[key]->New();
-  return std::shared_ptr<google::protobuf::Message>(m);
+  throw std::runtime_error(msg);
 }
 
 
@@ -318,11 +401,52 @@ MessageRegister::serialize(uint16_t component_id, uint16_t msg_type,
  */
 std::shared_ptr<google::protobuf::Message>
 MessageRegister::deserialize(frame_header_t &frame_header, message_header_t &message_header, void *data)
+{
+  return deserialize(frame_header, message_header, data, false);
+}
+
+
+/** Deserialize message, optionally into an arena.
+ * With @p use_arena the message and all of its sub-messages and strings
+ * are created in a protobuf arena sized for the message, instead of
+ * allocating each of them separately. The arena is freed when the last
+ * copy of the returned pointer is gone. Without arena support in the
+ * protobuf library (before 3.0) the message is allocated normally.
+ * @param frame_header incoming message's frame header
+ * @param message_header incoming message's message header
+ * @param data incoming message's data buffer
+ * @param use_arena true to create the message in an arena
+ * @return new instance of a protobuf message that has been registered
+ * for the given type.
+ * @exception std::runtime_error thrown if anything goes wrong when
+ * deserializing the message, e.g. if no protobuf message has been registered
+ * for the given component ID and message type.
+ */
+std::shared_ptr<google::protobuf::Message>
+MessageRegister::deserialize(frame_header_t &frame_header, message_header_t &message_header,
+			     void *data, bool use_arena)
 {
   uint16_t comp_id   = ntohs(message_header.component_id);
   uint16_t msg_type  = ntohs(message_header.msg_type);
   size_t   data_size = ntohl(frame_header.payload_size) - sizeof(message_header);
 
+#if GOOGLE_PROTOBUF_VERSION >= 3000000
+  if (use_arena) {
+    // parsed messages take a few times their wire size
+    google::protobuf::ArenaOptions options;
+    options.start_block_size = std::max<size_t>(256, 4 * data_size);
+    std::shared_ptr<google::protobuf::Arena> arena =
+      std::make_shared<google::protobuf::Arena>(options);
+
+    google::protobuf::Message *m = prototype_for(comp_id, msg_type)->New(arena.get());
+    if (! m->ParseFromArray(data, data_size)) {
+      throw std::runtime_error("Failed to parse message");
+    }
+    // shares ownership of the arena, does not delete the message itself
+    return std::shared_ptr<google::protobuf::Message>(arena, m);
+  }
+#endif
+
   std::shared_ptr<google::protobuf::Message> m =
     new_message_for(comp_id, msg_type);
   if (! m->ParseFromArray(data, data_size)) {
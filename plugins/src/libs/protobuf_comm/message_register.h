@@ -45,7 +45,9 @@
 #include <boost/utility.hpp>
 #include <boost/thread/mutex.hpp>
 
+#include <atomic>
 #include <map>
+#include <vector>
 #include <cstdint>
 #include <stdexcept>
 #include <memory>
@@ -86,6 +88,7 @@ class MessageRegister : boost::noncopyable
   add_message_type(uint16_t component_id, uint16_t msg_type)
   {
     KeyType key(component_id, msg_type);
+    std::lock_guard<std::mutex> lock(maps_mutex_);
     if (message_by_comp_type_.find(key) != message_by_comp_type_.end()) {
 #if defined(__GNUC__) && (__GNUC__ < 4 || (__GNUC__ == 4 && __GNUC_MINOR__ < 6))
       std::string msg = "Message type " + std::to_string((long long)component_id) + ":" +
@@ -99,6 +102,7 @@ class MessageRegister : boost::noncopyable
     MT *m = new MT();
     message_by_comp_type_[key] = m;
     message_by_typename_[m->GetDescriptor()->full_name()] = m;
+    publish_type_table();
   }
 
   /** Add a new message type.
@@ -112,6 +116,7 @@ class MessageRegister : boost::noncopyable
     MT m;
     const google::protobuf::Descriptor *desc = m.GetDescriptor();
     KeyType key = key_from_desc(desc);
+    std::lock_guard<std::mutex> lock(maps_mutex_);
     if (message_by_comp_type_.find(key) != message_by_comp_type_.end()) {
 #if defined(__GNUC__) && (__GNUC__ < 4 || (__GNUC__ == 4 && __GNUC_MINOR__ < 6))
       std::string msg = "Message type " + std::to_string((long long int)key.first) + ":" +
@@ -125,10 +130,13 @@ class MessageRegister : boost::noncopyable
     MT *new_m = new MT();
     message_by_comp_type_[key] = new_m;
     message_by_typename_[new_m->GetTypeName()] = new_m;
+    publish_type_table();
   }
 
   void remove_message_type(uint16_t component_id, uint16_t msg_type);
 
+  void freeze();
+
   std::shared_ptr<google::protobuf::Message>
   new_message_for(uint16_t component_id, uint16_t msg_type);
 
@@ -144,6 +152,10 @@ class MessageRegister : boost::noncopyable
   deserialize(frame_header_t &frame_header,
 	      message_header_t &message_header,
 	      void *data);
+  std::shared_ptr<google::protobuf::Message>
+  deserialize(frame_header_t &frame_header,
+	      message_header_t &message_header,
+	      void *data, bool use_arena);
 
   /** Mapping from message type to load error message. */
   typedef std::multimap<std::string, std::string> LoadFailMap;
@@ -160,14 +172,27 @@ class MessageRegister : boost::noncopyable
   typedef std::pair<uint16_t, uint16_t> KeyType;
   typedef std::map<KeyType, google::protobuf::Message *> TypeMap;
   typedef std::map<std::string, google::protobuf::Message *> TypeNameMap;
+  /// registered types sorted by (component_id << 16 | msg_type)
+  typedef std::vector<std::pair<uint32_t, const google::protobuf::Message *>> TypeTable;
 
   KeyType key_from_desc(const google::protobuf::Descriptor *desc);
   google::protobuf::Message * create_msg(std::string &msg_type);
+  const google::protobuf::Message * prototype_for(uint16_t component_id, uint16_t msg_type);
+  void publish_type_table();
 
   std::mutex maps_mutex_;
   TypeMap message_by_comp_type_;
   TypeNameMap message_by_typename_;
 
+  // flat copy of message_by_comp_type_ read without locking, NULL until
+  // frozen and replaced on changes after that
+  bool frozen_;
+  std::atomic<const TypeTable *> type_table_;
+  // replaced tables and removed types, readers may still use them,
+  // freed on destruction
+  std::vector<const TypeTable *> retired_type_tables_;
+  std::vector<google::protobuf::Message *> removed_types_;
+
   google::protobuf::compiler::DiskSourceTree  *pb_srctree_;
   google::protobuf::compiler::Importer        *pb_importer_;
   google::protobuf::MessageFactory            *pb_factory_;
@@ -501,7 +501,7 @@ void
 ProtobufBroadcastPeer::handle_sent(const boost::system::error_code& error,
 				   size_t bytes_transferred, QueueEntry *entry)
 {
-  delete entry;
+  outbound_pool_.release(entry);
 
   {
     std::lock_guard<std::mutex> lock(outbound_mutex_);
@@ -525,12 +525,18 @@ void
 ProtobufBroadcastPeer::send(uint16_t component_id, uint16_t msg_type,
 			    google::protobuf::Message &m)
 {
-  QueueEntry *entry = new QueueEntry();
-  message_register_->serialize(component_id, msg_type, m,
-			       entry->frame_header, entry->message_header,
-			       entry->serialized_message);
+  QueueEntry *entry = outbound_pool_.acquire();
+  try {
+    message_register_->serialize(component_id, msg_type, m,
+				 entry->frame_header, entry->message_header,
+				 entry->serialized_message);
+  } catch (std::runtime_error &e) {
+    outbound_pool_.release(entry);
+    throw;
+  }
 
   if (entry->serialized_message.size() > max_packet_length) {
+    outbound_pool_.release(entry);
     throw std::runtime_error("Serialized message too big");
   }
 
@@ -565,9 +571,9 @@ void
 ProtobufBroadcastPeer::send_raw(const frame_header_t &frame_header,
 				const void *data, size_t data_size)
 {
-  QueueEntry *entry = new QueueEntry();
+  QueueEntry *entry = outbound_pool_.acquire();
   entry->frame_header = frame_header;
-  entry->serialized_message = std::string(reinterpret_cast<const char *>(data), data_size);
+  entry->serialized_message.assign(reinterpret_cast<const char *>(data), data_size);
 
   entry->buffers[0] = boost::asio::buffer(&entry->frame_header, sizeof(frame_header_t));
   entry->buffers[1] = boost::asio::const_buffer();
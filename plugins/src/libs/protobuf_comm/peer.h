@@ -184,6 +184,7 @@ class ProtobufBroadcastPeer
   std::queue<QueueEntry *> outbound_queue_;
   std::mutex               outbound_mutex_;
   bool                     outbound_active_;
+  QueueEntryPool           outbound_pool_;
 
   boost::asio::ip::udp::endpoint outbound_endpoint_;
   boost::asio::ip::udp::endpoint in_endpoint_;
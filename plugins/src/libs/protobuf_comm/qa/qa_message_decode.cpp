@@ -0,0 +1,179 @@
+
+/***************************************************************************
+ *  qa_message_decode.cpp - protobuf_comm message decode benchmark
+ *
+ *  Created: Sat Oct 17 12:15:38 2026
+ *  Copyright  2026  agent
+ ****************************************************************************/
+
+/*  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in
+ *   the documentation and/or other materials provided with the
+ *   distribution.
+ * - Neither the name of the authors nor the names of its contributors
+ *   may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <protobuf_comm/message_register.h>
+
+#include <llsf_msgs/MachineCommands.pb.h>
+#include <llsf_msgs/MachineInfo.pb.h>
+
+#include <sys/time.h>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+using namespace protobuf_comm;
+using namespace llsf_msgs;
+
+/// @cond QA
+
+static size_t num_allocations = 0;
+
+void *
+operator new(size_t size)
+{
+  ++num_allocations;
+  void *p = malloc(size);
+  if (! p)  throw std::bad_alloc();
+  return p;
+}
+
+void
+operator delete(void *p) noexcept
+{
+  free(p);
+}
+
+static double
+now()
+{
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec + tv.tv_usec / 1000000.;
+}
+
+// a received message as it is handed to the message register
+struct Received {
+  frame_header_t   frame_header;
+  message_header_t message_header;
+  std::string      data;
+};
+
+static void
+decode(MessageRegister &mr, Received &r, unsigned int num_msgs, bool use_arena,
+       const char *name)
+{
+  size_t allocations_start = num_allocations;
+  double start = now();
+  for (unsigned int i = 0; i < num_msgs; ++i) {
+    std::shared_ptr<google::protobuf::Message> m =
+      mr.deserialize(r.frame_header, r.message_header, &r.data[0], use_arena);
+  }
+  double time = now() - start;
+  printf("  %-8s %12.0f msgs/s  %8.1f MB/s  %6.2f allocations/msg\n", name,
+	 num_msgs / time, num_msgs * r.data.size() / time / 1000000.,
+	 (double)(num_allocations - allocations_start) / num_msgs);
+}
+
+static void
+lookup(MessageRegister &mr, unsigned int num_msgs, const char *name)
+{
+  double start = now();
+  for (unsigned int i = 0; i < num_msgs; ++i) {
+    std::shared_ptr<google::protobuf::Message> m =
+      (i % 2 == 0) ? mr.new_message_for(SetMachineState::COMP_ID, SetMachineState::MSG_TYPE)
+                   : mr.new_message_for(MachineInfo::COMP_ID, MachineInfo::MSG_TYPE);
+  }
+  printf("  %-8s %12.0f msgs/s\n", name, num_msgs / (now() - start));
+}
+
+int
+main(int argc, char **argv)
+{
+  unsigned int num_msgs = 200000;
+  if (argc > 1)  num_msgs = atoi(argv[1]);
+
+  MessageRegister mr;
+  mr.add_message_type<SetMachineState>();
+  mr.add_message_type<MachineInfo>();
+  mr.add_message_type<Machine>();
+  mr.add_message_type<MachineAddBase>();
+
+  printf("Type lookup and creation, %u messages\n", num_msgs);
+  lookup(mr, num_msgs, "locked");
+  mr.freeze();
+  lookup(mr, num_msgs, "frozen");
+
+  SetMachineState set_state;
+  set_state.set_machine_name("C-CS1");
+  set_state.set_state(PROCESSED);
+
+  // the refbox broadcasts the state of all machines of both teams
+  MachineInfo info;
+  const char *types[] = {"BS", "DS", "RS", "RS", "CS", "CS", "SS"};
+  for (unsigned int i = 0; i < 14; ++i) {
+    Machine *machine = info.add_machines();
+    std::string team = (i < 7) ? "C-" : "M-";
+    machine->set_name(team + types[i % 7] + std::to_string(i % 7 + 1));
+    machine->set_type(types[i % 7]);
+    machine->set_state("IDLE");
+    machine->set_team_color((i < 7) ? CYAN : MAGENTA);
+    machine->set_prepared(false);
+    for (unsigned int l = 0; l < 3; ++l) {
+      LightSpec *light = machine->add_lights();
+      light->set_color((LightColor)l);
+      light->set_state(ON);
+    }
+    Pose2D *pose = machine->mutable_pose();
+    pose->mutable_timestamp()->set_sec(1458209528);
+    pose->mutable_timestamp()->set_nsec(123456789);
+    pose->set_x(i * 0.5);
+    pose->set_y(i * 0.25);
+    pose->set_ori(1.57);
+    machine->set_zone((Zone)(i + 1));
+    machine->add_ring_colors(RING_BLUE);
+    machine->add_ring_colors(RING_GREEN);
+  }
+
+  Received received[2];
+  mr.serialize(SetMachineState::COMP_ID, SetMachineState::MSG_TYPE, set_state,
+	       received[0].frame_header, received[0].message_header, received[0].data);
+  mr.serialize(MachineInfo::COMP_ID, MachineInfo::MSG_TYPE, info,
+	       received[1].frame_header, received[1].message_header, received[1].data);
+
+  printf("SetMachineState, %zu bytes, %u messages\n", received[0].data.size(), num_msgs);
+  decode(mr, received[0], num_msgs, false, "heap");
+  decode(mr, received[0], num_msgs, true, "arena");
+
+  printf("MachineInfo, %zu bytes, %u messages\n", received[1].data.size(), num_msgs / 10);
+  decode(mr, received[1], num_msgs / 10, false, "heap");
+  decode(mr, received[1], num_msgs / 10, true, "arena");
+
+  return 0;
+}
+
+/// @endcond
@@ -0,0 +1,154 @@
+
+/***************************************************************************
+ *  qa_queue_entry_pool.cpp - protobuf_comm send queue entry benchmark
+ *
+ *  Created: Sat Oct 17 12:06:53 2026
+ *  Copyright  2026  agent
+ ****************************************************************************/
+
+/*  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in
+ *   the documentation and/or other materials provided with the
+ *   distribution.
+ * - Neither the name of the authors nor the names of its contributors
+ *   may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <protobuf_comm/message_register.h>
+#include <protobuf_comm/queue_entry.h>
+
+#include <llsf_msgs/MachineCommands.pb.h>
+#include <llsf_msgs/SimTimeSync.pb.h>
+
+#include <sys/time.h>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+using namespace protobuf_comm;
+using namespace llsf_msgs;
+
+/// @cond QA
+
+static size_t num_allocations = 0;
+
+void *
+operator new(size_t size)
+{
+  ++num_allocations;
+  void *p = malloc(size);
+  if (! p)  throw std::bad_alloc();
+  return p;
+}
+
+void
+operator delete(void *p) noexcept
+{
+  free(p);
+}
+
+static double
+now()
+{
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec + tv.tv_usec / 1000000.;
+}
+
+// what the send methods do with an entry before it is queued
+static void
+fill_entry(MessageRegister &mr, QueueEntry *entry, google::protobuf::Message &m,
+	   uint16_t comp_id, uint16_t msg_type)
+{
+  mr.serialize(comp_id, msg_type, m, entry->frame_header, entry->message_header,
+	       entry->serialized_message);
+  entry->buffers[0] = boost::asio::buffer(&entry->frame_header, sizeof(frame_header_t));
+  entry->buffers[1] = boost::asio::buffer(&entry->message_header, sizeof(message_header_t));
+  entry->buffers[2] = boost::asio::buffer(entry->serialized_message);
+}
+
+static void
+report(const char *name, double time, size_t allocations, unsigned int num_msgs)
+{
+  printf("  %-12s %12.0f msgs/s  %6.2f allocations/msg\n", name,
+	 num_msgs / time, (double)allocations / num_msgs);
+}
+
+int
+main(int argc, char **argv)
+{
+  unsigned int num_msgs = 1000000;
+  if (argc > 1)  num_msgs = atoi(argv[1]);
+
+  MessageRegister mr;
+
+  // the messages the simulation sends to the refbox most often
+  SetMachineState set_state;
+  set_state.set_machine_name("C-CS1");
+  set_state.set_state(PROCESSED);
+  SimTimeSync time_sync;
+  time_sync.mutable_sim_time()->set_sec(1458209528);
+  time_sync.mutable_sim_time()->set_nsec(123456789);
+  time_sync.set_real_time_factor(1.0);
+  time_sync.set_paused(false);
+
+  printf("%u messages, alternating SetMachineState and SimTimeSync\n", num_msgs);
+
+  size_t allocations_start = num_allocations;
+  double start = now();
+  for (unsigned int i = 0; i < num_msgs; ++i) {
+    QueueEntry *entry = new QueueEntry();
+    if (i % 2 == 0) {
+      fill_entry(mr, entry, set_state, SetMachineState::COMP_ID, SetMachineState::MSG_TYPE);
+    } else {
+      fill_entry(mr, entry, time_sync, SimTimeSync::COMP_ID, SimTimeSync::MSG_TYPE);
+    }
+    delete entry;
+  }
+  report("new/delete", now() - start, num_allocations - allocations_start, num_msgs);
+
+  // a few entries in flight, as when the asio thread lags behind
+  QueueEntryPool pool;
+  QueueEntry *in_flight[4] = {NULL, NULL, NULL, NULL};
+  allocations_start = num_allocations;
+  start = now();
+  for (unsigned int i = 0; i < num_msgs; ++i) {
+    QueueEntry *&slot = in_flight[i % 4];
+    if (slot)  pool.release(slot);
+    slot = pool.acquire();
+    if (i % 2 == 0) {
+      fill_entry(mr, slot, set_state, SetMachineState::COMP_ID, SetMachineState::MSG_TYPE);
+    } else {
+      fill_entry(mr, slot, time_sync, SimTimeSync::COMP_ID, SimTimeSync::MSG_TYPE);
+    }
+  }
+  for (QueueEntry *entry : in_flight) {
+    if (entry)  pool.release(entry);
+  }
+  report("pool", now() - start, num_allocations - allocations_start, num_msgs);
+  printf("  pool created %zu entries\n", pool.allocated());
+
+  return 0;
+}
+
+/// @endcond
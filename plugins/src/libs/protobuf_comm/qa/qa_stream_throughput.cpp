@@ -0,0 +1,153 @@
+
+/***************************************************************************
+ *  qa_stream_throughput.cpp - protobuf_comm stream send benchmark
+ *
+ *  Created: Sat Oct 17 12:10:33 2026
+ *  Copyright  2026  agent
+ ****************************************************************************/
+
+/*  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in
+ *   the documentation and/or other materials provided with the
+ *   distribution.
+ * - Neither the name of the authors nor the names of its contributors
+ *   may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <protobuf_comm/client.h>
+#include <protobuf_comm/server.h>
+
+#include <llsf_msgs/MachineCommands.pb.h>
+
+#include <sys/time.h>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+
+using namespace protobuf_comm;
+using namespace llsf_msgs;
+
+/// @cond QA
+
+static std::mutex mutex;
+static std::condition_variable cond;
+static unsigned int received = 0;
+static bool client_connected = false;
+static ProtobufStreamServer::ClientID client_id;
+static bool server_connected = false;
+
+static double
+now()
+{
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec + tv.tv_usec / 1000000.;
+}
+
+static void
+count_message()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  ++received;
+  cond.notify_all();
+}
+
+static void
+wait_for(unsigned int num_msgs)
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  cond.wait(lock, [num_msgs]{ return received >= num_msgs; });
+  received = 0;
+}
+
+static void
+report(const char *name, double time, unsigned int num_msgs, size_t msg_size)
+{
+  printf("  %-18s %10.0f msgs/s  %7.2f MB/s\n", name, num_msgs / time,
+	 num_msgs * (msg_size + sizeof(frame_header_t) + sizeof(message_header_t)) / time / 1e6);
+}
+
+int
+main(int argc, char **argv)
+{
+  unsigned int num_msgs = 200000;
+  unsigned short port = 4445;
+  if (argc > 1)  num_msgs = atoi(argv[1]);
+  if (argc > 2)  port = atoi(argv[2]);
+
+  // 100 bytes serialized: two bytes for each field's tag and length or value
+  SetMachineState msg;
+  msg.set_machine_name(std::string(96, 'M'));
+  msg.set_state(PROCESSED);
+
+  ProtobufStreamServer server(port);
+  server.message_register().add_message_type<SetMachineState>();
+  server.signal_received().connect(
+    [](ProtobufStreamServer::ClientID, uint16_t, uint16_t,
+       std::shared_ptr<google::protobuf::Message>) { count_message(); });
+  server.signal_connected().connect(
+    [](ProtobufStreamServer::ClientID id, boost::asio::ip::tcp::endpoint &) {
+      std::lock_guard<std::mutex> lock(mutex);
+      client_id = id;
+      server_connected = true;
+      cond.notify_all();
+    });
+
+  ProtobufStreamClient client;
+  client.message_register().add_message_type<SetMachineState>();
+  client.signal_received().connect(
+    [](uint16_t, uint16_t, std::shared_ptr<google::protobuf::Message>) { count_message(); });
+  client.signal_connected().connect(
+    []() {
+      std::lock_guard<std::mutex> lock(mutex);
+      client_connected = true;
+      cond.notify_all();
+    });
+  client.async_connect("127.0.0.1", port);
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    cond.wait(lock, []{ return client_connected && server_connected; });
+  }
+
+  printf("%u messages of %d bytes over loopback\n", num_msgs, msg.ByteSize());
+
+  double start = now();
+  for (unsigned int i = 0; i < num_msgs; ++i) {
+    client.send(msg);
+  }
+  wait_for(num_msgs);
+  report("client to server", now() - start, num_msgs, msg.ByteSize());
+
+  start = now();
+  for (unsigned int i = 0; i < num_msgs; ++i) {
+    server.send(client_id, msg);
+  }
+  wait_for(num_msgs);
+  report("server to client", now() - start, num_msgs, msg.ByteSize());
+
+  client.disconnect();
+  return 0;
+}
+
+/// @endcond
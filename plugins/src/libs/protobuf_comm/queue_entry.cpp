@@ -0,0 +1,193 @@
+
+/***************************************************************************
+ *  queue_entry.cpp - Protobuf stream protocol - send queue entry pool
+ *
+ *  Created: Sat Oct 17 12:06:53 2026
+ *  Copyright  2026  agent
+ ****************************************************************************/
+
+/*  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in
+ *   the documentation and/or other materials provided with the
+ *   distribution.
+ * - Neither the name of the authors nor the names of its contributors
+ *   may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <protobuf_comm/queue_entry.h>
+
+namespace protobuf_comm {
+#if 0 /* just to make Emacs auto-indent happy */
+}
+#endif
+
+/** @class QueueEntryPool <protobuf_comm/queue_entry.h>
+ * Pool of outgoing queue entries.
+ * Each connection keeps released entries in a free list and hands them
+ * out again for the next messages. The serialization buffers of the
+ * entries keep their capacity, so in steady state sending a message does
+ * not allocate memory. Entries may be acquired and released from
+ * different threads.
+ * @author agent
+ */
+
+/** Constructor.
+ * @param max_free maximum number of entries kept in the free list, further
+ * released entries are deleted
+ * @param max_buffer_size buffers larger than this are released with the
+ * entry instead of being kept for reuse
+ */
+QueueEntryPool::QueueEntryPool(size_t max_free, size_t max_buffer_size)
+  : max_free_(max_free), max_buffer_size_(max_buffer_size), allocated_(0)
+{
+  free_.reserve(max_free_);
+}
+
+
+/** Destructor.
+ * Entries still in use are not owned by the pool and must be deleted by
+ * the user.
+ */
+QueueEntryPool::~QueueEntryPool()
+{
+  for (QueueEntry *entry : free_) {
+    delete entry;
+  }
+}
+
+
+/** Get an entry.
+ * @return entry with default frame header and empty buffers, to be given
+ * back with release()
+ */
+QueueEntry *
+QueueEntryPool::acquire()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (! free_.empty()) {
+      QueueEntry *entry = free_.back();
+      free_.pop_back();
+      return entry;
+    }
+    ++allocated_;
+  }
+  return new QueueEntry();
+}
+
+
+/** Give back an entry.
+ * @param entry entry acquired from this pool, which is no longer used
+ */
+void
+QueueEntryPool::release(QueueEntry *entry)
+{
+  entry->frame_header.header_version = PB_FRAME_V2;
+  entry->frame_header.cipher         = PB_ENCRYPTION_NONE;
+  entry->buffers.fill(boost::asio::const_buffer());
+  if (entry->serialized_message.capacity() > max_buffer_size_) {
+    std::string().swap(entry->serialized_message);
+  } else {
+    entry->serialized_message.clear();
+  }
+  if (entry->encrypted_message.capacity() > max_buffer_size_) {
+    std::string().swap(entry->encrypted_message);
+  } else {
+    entry->encrypted_message.clear();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (free_.size() < max_free_) {
+      free_.push_back(entry);
+      return;
+    }
+  }
+  delete entry;
+}
+
+
+/** @class QueueEntryBatch <protobuf_comm/queue_entry.h>
+ * Queued entries written with one gathered write.
+ * Instead of one write and completion per message, all pending entries
+ * of a send queue are collected up to a limit and their buffers are
+ * handed to a single write operation.
+ * Asio passes at most 64 buffers to one system call, the default limit of
+ * 21 entries with three buffers each keeps a batch within one call.
+ * @author agent
+ */
+
+/** Constructor.
+ * @param max_entries maximum number of entries in one batch
+ * @param max_bytes maximum number of bytes in one batch, a single larger
+ * entry is still written alone
+ */
+QueueEntryBatch::QueueEntryBatch(size_t max_entries, size_t max_bytes)
+  : max_entries_(max_entries), max_bytes_(max_bytes)
+{
+  entries_.reserve(max_entries_);
+  buffers_.reserve(max_entries_ * 3);
+}
+
+
+/** Move entries from a queue into the batch.
+ * Takes at least one entry if the queue is not empty.
+ * @param queue queue to take the entries from, the caller must hold the
+ * lock protecting it
+ * @return number of bytes in the batch
+ */
+size_t
+QueueEntryBatch::gather(std::queue<QueueEntry *> &queue)
+{
+  size_t bytes = 0;
+  while (! queue.empty() && entries_.size() < max_entries_) {
+    QueueEntry *entry = queue.front();
+    size_t entry_bytes = boost::asio::buffer_size(entry->buffers);
+    if (! entries_.empty() && bytes + entry_bytes > max_bytes_)  break;
+
+    queue.pop();
+    entries_.push_back(entry);
+    for (const boost::asio::const_buffer &b : entry->buffers) {
+      if (boost::asio::buffer_size(b) > 0)  buffers_.push_back(b);
+    }
+    bytes += entry_bytes;
+  }
+  return bytes;
+}
+
+
+/** Give all entries back to the pool and empty the batch.
+ * @param pool pool the entries were acquired from
+ */
+void
+QueueEntryBatch::release(QueueEntryPool &pool)
+{
+  for (QueueEntry *entry : entries_) {
+    pool.release(entry);
+  }
+  entries_.clear();
+  buffers_.clear();
+}
+
+} // end namespace protobuf_comm
@@ -37,8 +37,15 @@
 #ifndef __PROTOBUF_COMM_QUEUE_ENTRY_H_
 #define __PROTOBUF_COMM_QUEUE_ENTRY_H_
 
+#include <protobuf_comm/frame_header.h>
+
 #include <boost/asio.hpp>
 #include <array>
+#include <cstddef>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <vector>
 
 namespace protobuf_comm {
 #if 0 /* just to make Emacs auto-indent happy */
@@ -63,6 +70,51 @@ public:
 };
 
 
+class QueueEntryPool
+{
+ public:
+  QueueEntryPool(size_t max_free = 32, size_t max_buffer_size = 65536);
+  ~QueueEntryPool();
+
+  QueueEntry * acquire();
+  void         release(QueueEntry *entry);
+
+  /** Get number of entries created by the pool.
+   * @return number of entries allocated so far */
+  size_t allocated() const { return allocated_; }
+
+ private:
+  std::mutex                mutex_;
+  std::vector<QueueEntry *> free_;
+  size_t                    max_free_;
+  size_t                    max_buffer_size_;
+  size_t                    allocated_;
+};
+
+
+class QueueEntryBatch
+{
+ public:
+  QueueEntryBatch(size_t max_entries = 21, size_t max_bytes = 65536);
+
+  size_t gather(std::queue<QueueEntry *> &queue);
+  void   release(QueueEntryPool &pool);
+
+  /** Get buffers of all entries of the batch.
+   * @return buffers to write with a single gathered write */
+  const std::vector<boost::asio::const_buffer> & buffers() const { return buffers_; }
+  /** Check if the batch is empty.
+   * @return true if no entry was gathered */
+  bool empty() const { return entries_.empty(); }
+
+ private:
+  size_t                                  max_entries_;
+  size_t                                  max_bytes_;
+  std::vector<QueueEntry *>               entries_;
+  std::vector<boost::asio::const_buffer>  buffers_;
+};
+
+
 } // end namespace protobuf_comm
 
 #endif
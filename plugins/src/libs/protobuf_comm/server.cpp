@@ -110,26 +110,24 @@ void
 ProtobufStreamServer::Session::send(uint16_t component_id, uint16_t msg_type,
 				    google::protobuf::Message &m)
 {
-  QueueEntry *entry = new QueueEntry();
-  parent_->message_register().serialize(component_id, msg_type, m,
-					entry->frame_header, entry->message_header,
-					entry->serialized_message);
+  QueueEntry *entry = outbound_pool_.acquire();
+  try {
+    parent_->message_register().serialize(component_id, msg_type, m,
+					  entry->frame_header, entry->message_header,
+					  entry->serialized_message);
+  } catch (std::runtime_error &e) {
+    outbound_pool_.release(entry);
+    throw;
+  }
 
   entry->buffers[0] = boost::asio::buffer(&entry->frame_header, sizeof(frame_header_t));
   entry->buffers[1] = boost::asio::buffer(&entry->message_header, sizeof(message_header_t));
   entry->buffers[2] = boost::asio::buffer(entry->serialized_message);
  
   std::lock_guard<std::mutex> lock(outbound_mutex_);
-  if (outbound_active_) {
-    outbound_queue_.push(entry);
-  } else {
-    outbound_active_ = true;
-    boost::asio::async_write(socket_, entry->buffers,
-			     boost::bind(&ProtobufStreamServer::Session::handle_write,
-					 shared_from_this(),
-					 boost::asio::placeholders::error,
-					 boost::asio::placeholders::bytes_transferred,
-					 entry));
+  outbound_queue_.push(entry);
+  if (! outbound_active_) {
+    start_write();
   }
 }
 
@@ -146,25 +144,33 @@ ProtobufStreamServer::Session::disconnect()
 }
 
 
+/** Write all queued messages with one gathered write.
+ * The outbound mutex must be held and the queue must not be empty.
+ */
+void
+ProtobufStreamServer::Session::start_write()
+{
+  outbound_active_ = true;
+  outbound_batch_.gather(outbound_queue_);
+  boost::asio::async_write(socket_, outbound_batch_.buffers(),
+			   boost::bind(&ProtobufStreamServer::Session::handle_write,
+				       shared_from_this(),
+				       boost::asio::placeholders::error,
+				       boost::asio::placeholders::bytes_transferred));
+}
+
+
 /** Write completion handler. */
 void
 ProtobufStreamServer::Session::handle_write(const boost::system::error_code& error,
-					    size_t /*bytes_transferred*/,
-					    QueueEntry *entry)
+					    size_t /*bytes_transferred*/)
 {
-  delete entry;
+  outbound_batch_.release(outbound_pool_);
 
   if (! error) {
     std::lock_guard<std::mutex> lock(outbound_mutex_);
     if (! outbound_queue_.empty()) {
-      QueueEntry *entry = outbound_queue_.front();
-      outbound_queue_.pop();
-      boost::asio::async_write(socket_, entry->buffers,
-			       boost::bind(&ProtobufStreamServer::Session::handle_write,
-					   shared_from_this(),
-					   boost::asio::placeholders::error,
-					   boost::asio::placeholders::bytes_transferred,
-					   entry));
+      start_write();
     } else {
       outbound_active_ = false;
     }
@@ -224,7 +230,8 @@ ProtobufStreamServer::Session::handle_read_message(const boost::system::error_co
     try {
       std::shared_ptr<google::protobuf::Message> m =
 	parent_->message_register().deserialize(in_frame_header_, *message_header,
-						(char *)in_data_ + sizeof(message_header_t));
+						(char *)in_data_ + sizeof(message_header_t),
+						parent_->arena_parsing_);
       parent_->sig_rcvd_(id_, comp_id, msg_type, m);
     } catch (std::runtime_error &e) {
       // ignored, most likely unknown message tpye
@@ -255,6 +262,7 @@ ProtobufStreamServer::ProtobufStreamServer(unsigned short port)
   message_register_ = new MessageRegister();
   own_message_register_ = true;
   next_cid_ = 1;
+  arena_parsing_ = false;
 
   acceptor_.set_option(socket_base::reuse_address(true));
 
@@ -277,6 +285,7 @@ ProtobufStreamServer::ProtobufStreamServer(unsigned short port,
   message_register_ = new MessageRegister(proto_path);
   own_message_register_ = true;
   next_cid_ = 1;
+  arena_parsing_ = false;
 
   acceptor_.set_option(socket_base::reuse_address(true));
 
@@ -295,6 +304,7 @@ ProtobufStreamServer::ProtobufStreamServer(unsigned short port,
     message_register_(mr), own_message_register_(false)
 {
   next_cid_ = 1;
+  arena_parsing_ = false;
 
   acceptor_.set_option(socket_base::reuse_address(true));
 
@@ -455,6 +465,20 @@ ProtobufStreamServer::disconnect(ClientID client)
   }
 }
 
+
+/** Enable or disable parsing received messages into arenas.
+ * When enabled, each received message and its sub-messages are allocated
+ * in one protobuf arena that is freed with the last reference to the
+ * message. Must be set before clients connect.
+ * @param enabled true to parse into arenas, false to allocate messages
+ * on the heap (the default)
+ */
+void
+ProtobufStreamServer::set_arena_parsing(bool enabled)
+{
+  arena_parsing_ = enabled;
+}
+
 /** Start accepting connections. */
 void
 ProtobufStreamServer::start_accept()
@@ -88,6 +88,8 @@ class ProtobufStreamServer
 
   void disconnect(ClientID client);
 
+  void set_arena_parsing(bool enabled);
+
   /** Get the server's message register.
    * @return message register
    */
@@ -151,8 +153,9 @@ class ProtobufStreamServer
    private:
     void handle_read_message(const boost::system::error_code& error);
     void handle_read_header(const boost::system::error_code& error);
+    void start_write();
     void handle_write(const boost::system::error_code& error,
-		      size_t /*bytes_transferred*/, QueueEntry *entry);
+		      size_t /*bytes_transferred*/);
 
    private:
     ClientID id_;
@@ -167,6 +170,8 @@ class ProtobufStreamServer
     std::queue<QueueEntry *> outbound_queue_;
     std::mutex               outbound_mutex_;
     bool                     outbound_active_;
+    QueueEntryPool           outbound_pool_;
+    QueueEntryBatch          outbound_batch_;
   };
 
  private: // methods
@@ -200,6 +205,7 @@ class ProtobufStreamServer
 
   MessageRegister *message_register_;
   bool             own_message_register_;
+  bool             arena_parsing_;
 };
 
 } // end namespace protobuf_comm
@@ -0,0 +1,173 @@
+/***************************************************************************
+ *  point_cloud_packer.cpp - Copy camera point clouds into a packed buffer
+ *
+ *  Created: Sat Oct 17 11:59:08 2026
+ *  Copyright  2026  agent
+ *
+ ****************************************************************************/
+
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version. A runtime exception applies to
+ *  this software (see LICENSE.GPL_WRE file mentioned below for details).
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.GPL_WRE file in the doc directory.
+ */
+
+#include <utils/geometry/point_cloud_packer.h>
+
+#include <cmath>
+#include <cstring>
+
+namespace fawkes {
+#if 0 /* just to make Emacs auto-indent happy */
+}
+#endif
+
+/** @class PointCloudPacker <utils/geometry/point_cloud_packer.h>
+ * Copy camera point clouds into a packed buffer.
+ * The input is a cloud as delivered by a depth camera, four floats
+ * x, y, z, rgba per point, row by row. The output buffer holds the
+ * points as consecutive floats x, y, z and optionally rgba, so it can be
+ * sent as a single bytes field instead of one message per point.
+ *
+ * The cloud can be reduced by only taking every n-th pixel of every
+ * n-th row (the result stays organized) and by a voxel grid, which keeps
+ * the first valid point of every voxel (the result is unorganized).
+ * The buffer is reused, after the first frame packing does not allocate.
+ * @author agent
+ */
+
+/** Constructor.
+ * @param stride only take every stride-th pixel of every stride-th row
+ * @param voxel_size edge length of the voxels, 0 to disable the voxel grid
+ * @param with_color true to pack the rgba value of the points
+ */
+PointCloudPacker::PointCloudPacker(unsigned int stride, float voxel_size, bool with_color)
+  : stride_(stride > 0 ? stride : 1), voxel_size_(voxel_size), with_color_(with_color),
+    width_(0), height_(0)
+{
+}
+
+/** Set pixel stride.
+ * @param stride only take every stride-th pixel of every stride-th row
+ */
+void
+PointCloudPacker::set_stride(unsigned int stride)
+{
+  stride_ = stride > 0 ? stride : 1;
+}
+
+/** Set voxel size.
+ * @param voxel_size edge length of the voxels, 0 to disable the voxel grid
+ */
+void
+PointCloudPacker::set_voxel_size(float voxel_size)
+{
+  voxel_size_ = voxel_size;
+}
+
+/** Set if the color is packed.
+ * @param with_color true to pack the rgba value of the points
+ */
+void
+PointCloudPacker::set_with_color(bool with_color)
+{
+  with_color_ = with_color;
+}
+
+/** Pack a point cloud.
+ * @param pcd points of the camera, four floats per point
+ * @param width number of points per row
+ * @param height number of rows
+ * @param buffer buffer the packed points are written to, resized to the
+ * packed size
+ * @return number of packed points
+ */
+unsigned int
+PointCloudPacker::pack(const float *pcd, unsigned int width, unsigned int height,
+                       std::string &buffer)
+{
+  if (voxel_size_ > 0.f) {
+    return pack_voxels(pcd, width, height, buffer);
+  }
+
+  width_  = (width + stride_ - 1) / stride_;
+  height_ = (height + stride_ - 1) / stride_;
+  unsigned int num_points = width_ * height_;
+  buffer.resize((size_t)num_points * point_step());
+  char *out = &buffer[0];
+
+  if (stride_ == 1 && with_color_) {
+    //same layout as the camera
+    memcpy(out, pcd, (size_t)num_points * 4 * sizeof(float));
+    return num_points;
+  }
+
+  size_t point_size = point_step();
+  for (unsigned int r = 0; r < height; r += stride_) {
+    const float *row = pcd + (size_t)r * width * 4;
+    for (unsigned int c = 0; c < width; c += stride_) {
+      memcpy(out, row + (size_t)c * 4, point_size);
+      out += point_size;
+    }
+  }
+  return num_points;
+}
+
+unsigned int
+PointCloudPacker::pack_voxels(const float *pcd, unsigned int width, unsigned int height,
+                              std::string &buffer)
+{
+  //worst case size, shrunk afterwards without releasing the memory
+  buffer.resize((size_t)((width + stride_ - 1) / stride_) * ((height + stride_ - 1) / stride_)
+                * point_step());
+  char *out = &buffer[0];
+  size_t point_size = point_step();
+  float inv_size = 1.f / voxel_size_;
+  unsigned int num_points = 0;
+
+  //at most half filled, keys never have the highest bit set
+  size_t table_size = 1024;
+  while (table_size < buffer.size() / point_size * 2)  table_size *= 2;
+  voxels_.assign(table_size, ~0ULL);
+  size_t mask = table_size - 1;
+
+  for (unsigned int r = 0; r < height; r += stride_) {
+    const float *row = pcd + (size_t)r * width * 4;
+    for (unsigned int c = 0; c < width; c += stride_) {
+      const float *p = row + (size_t)c * 4;
+      if (! std::isfinite(p[0]) || ! std::isfinite(p[1]) || ! std::isfinite(p[2])) {
+        continue;
+      }
+      //21 bit per axis is plenty for the range of a depth camera
+      uint64_t key =
+        ((uint64_t)((int64_t)std::floor(p[0] * inv_size) & 0x1FFFFF) << 42) |
+        ((uint64_t)((int64_t)std::floor(p[1] * inv_size) & 0x1FFFFF) << 21) |
+        ((uint64_t)((int64_t)std::floor(p[2] * inv_size) & 0x1FFFFF));
+      size_t slot = (size_t)((key * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+      while (voxels_[slot] != key && voxels_[slot] != ~0ULL) {
+        slot = (slot + 1) & mask;
+      }
+      if (voxels_[slot] == ~0ULL) {
+        voxels_[slot] = key;
+        memcpy(out, p, point_size);
+        out += point_size;
+        ++num_points;
+      }
+    }
+  }
+
+  width_  = num_points;
+  height_ = 1;
+  buffer.resize((size_t)num_points * point_size);
+  return num_points;
+}
+
+} // end namespace fawkes
@@ -0,0 +1,76 @@
+/***************************************************************************
+ *  point_cloud_packer.h - Copy camera point clouds into a packed buffer
+ *
+ *  Created: Sat Oct 17 11:59:08 2026
+ *  Copyright  2026  agent
+ *
+ ****************************************************************************/
+
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version. A runtime exception applies to
+ *  this software (see LICENSE.GPL_WRE file mentioned below for details).
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.GPL_WRE file in the doc directory.
+ */
+
+#ifndef __UTILS_GEOMETRY_POINT_CLOUD_PACKER_H_
+#define __UTILS_GEOMETRY_POINT_CLOUD_PACKER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace fawkes {
+#if 0 /* just to make Emacs auto-indent happy */
+}
+#endif
+
+class PointCloudPacker
+{
+ public:
+  PointCloudPacker(unsigned int stride = 1, float voxel_size = 0.f, bool with_color = true);
+
+  void set_stride(unsigned int stride);
+  void set_voxel_size(float voxel_size);
+  void set_with_color(bool with_color);
+
+  unsigned int pack(const float *pcd, unsigned int width, unsigned int height,
+                    std::string &buffer);
+
+  /** Get bytes per packed point.
+   * @return 16 with color, 12 without */
+  unsigned int point_step() const { return with_color_ ? 16 : 12; }
+  /** Check if points are packed with color.
+   * @return true if the rgba value is packed */
+  bool with_color() const { return with_color_; }
+  /** Get width of the last packed cloud.
+   * @return number of points per row, all points if voxel filtered */
+  unsigned int width() const { return width_; }
+  /** Get height of the last packed cloud.
+   * @return number of rows, 1 if voxel filtered */
+  unsigned int height() const { return height_; }
+
+ private:
+  unsigned int pack_voxels(const float *pcd, unsigned int width, unsigned int height,
+                           std::string &buffer);
+
+ private:
+  unsigned int stride_;
+  float        voxel_size_;
+  bool         with_color_;
+  unsigned int width_;
+  unsigned int height_;
+  /// open addressing hash set of the occupied voxels
+  std::vector<uint64_t> voxels_;
+};
+
+} // end namespace fawkes
+
+#endif
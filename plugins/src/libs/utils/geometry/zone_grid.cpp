@@ -0,0 +1,184 @@
+
+/***************************************************************************
+ *  zone_grid.cpp - Uniform grid index over spherical zones
+ *
+ *  Created: Sat Oct 17 11:42:50 2026
+ *  Copyright  2026  agent
+ *
+ ****************************************************************************/
+
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version. A runtime exception applies to
+ *  this software (see LICENSE.GPL_WRE file mentioned below for details).
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.GPL_WRE file in the doc directory.
+ */
+
+#include <utils/geometry/zone_grid.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace fawkes {
+#if 0 /* just to make Emacs auto-indent happy */
+}
+#endif
+
+/** @class ZoneGrid <utils/geometry/zone_grid.h>
+ * Uniform grid index over spherical zones.
+ * Each zone is stored in all grid cells its bounding square in the
+ * x-y plane overlaps, so finding the zones containing a point only
+ * tests the few zones of a single cell instead of all zones.
+ * Zones may overlap, zone ids stay valid after removal of other zones.
+ * @author agent
+ */
+
+/** Constructor.
+ * @param cell_size edge length of a grid cell, should be in the order
+ * of the zone diameter
+ */
+ZoneGrid::ZoneGrid(float cell_size)
+  : cell_size_(cell_size)
+{
+}
+
+/** Add a zone.
+ * @param x x coordinate of the zone center
+ * @param y y coordinate of the zone center
+ * @param z z coordinate of the zone center
+ * @param radius radius of the zone
+ * @return id of the new zone
+ */
+unsigned int
+ZoneGrid::add_zone(float x, float y, float z, float radius)
+{
+  Zone zone = {x, y, z, radius, true};
+  zones_.push_back(zone);
+  insert_cells(zones_.size() - 1);
+  return zones_.size() - 1;
+}
+
+/** Move a zone.
+ * @param zone id of the zone
+ * @param x new x coordinate of the zone center
+ * @param y new y coordinate of the zone center
+ * @param z new z coordinate of the zone center
+ */
+void
+ZoneGrid::move_zone(unsigned int zone, float x, float y, float z)
+{
+  if (zone >= zones_.size() || ! zones_[zone].active)  return;
+  erase_cells(zone);
+  zones_[zone].x = x;
+  zones_[zone].y = y;
+  zones_[zone].z = z;
+  insert_cells(zone);
+}
+
+/** Remove a zone.
+ * The id is not reused.
+ * @param zone id of the zone
+ */
+void
+ZoneGrid::remove_zone(unsigned int zone)
+{
+  if (zone >= zones_.size() || ! zones_[zone].active)  return;
+  erase_cells(zone);
+  zones_[zone].active = false;
+}
+
+/** Find zones containing a point.
+ * @param x x coordinate of the point
+ * @param y y coordinate of the point
+ * @param z z coordinate of the point
+ * @param zones upon return contains the ids of all zones containing
+ * the point, in ascending order
+ */
+void
+ZoneGrid::find(float x, float y, float z, std::vector<unsigned int> &zones) const
+{
+  zones.clear();
+  std::unordered_map<Cell, std::vector<unsigned int>, CellHash>::const_iterator c = cells_.find(cell_of(x, y));
+  if (c == cells_.end())  return;
+
+  for (unsigned int id : c->second) {
+    const Zone &zone = zones_[id];
+    float dx = x - zone.x, dy = y - zone.y, dz = z - zone.z;
+    if (dx * dx + dy * dy + dz * dz < zone.radius * zone.radius) {
+      zones.push_back(id);
+    }
+  }
+}
+
+/** Find the zone with the center closest to a point.
+ * Only zones containing the point are considered.
+ * @param x x coordinate of the point
+ * @param y y coordinate of the point
+ * @param z z coordinate of the point
+ * @param zone upon return contains the id of the nearest zone, if any
+ * @return true if the point is inside a zone, false otherwise
+ */
+bool
+ZoneGrid::find_nearest(float x, float y, float z, unsigned int &zone) const
+{
+  std::unordered_map<Cell, std::vector<unsigned int>, CellHash>::const_iterator c = cells_.find(cell_of(x, y));
+  if (c == cells_.end())  return false;
+
+  bool found = false;
+  float min_dist = 0.;
+  for (unsigned int id : c->second) {
+    const Zone &candidate = zones_[id];
+    float dx = x - candidate.x, dy = y - candidate.y, dz = z - candidate.z;
+    float dist = dx * dx + dy * dy + dz * dz;
+    if (dist < candidate.radius * candidate.radius && (! found || dist < min_dist)) {
+      found = true;
+      min_dist = dist;
+      zone = id;
+    }
+  }
+  return found;
+}
+
+ZoneGrid::Cell
+ZoneGrid::cell_of(float x, float y) const
+{
+  return Cell((int)std::floor(x / cell_size_), (int)std::floor(y / cell_size_));
+}
+
+void
+ZoneGrid::insert_cells(unsigned int zone)
+{
+  const Zone &z = zones_[zone];
+  Cell min = cell_of(z.x - z.radius, z.y - z.radius);
+  Cell max = cell_of(z.x + z.radius, z.y + z.radius);
+  for (int i = min.first; i <= max.first; ++i) {
+    for (int j = min.second; j <= max.second; ++j) {
+      std::vector<unsigned int> &cell = cells_[Cell(i, j)];
+      cell.insert(std::lower_bound(cell.begin(), cell.end(), zone), zone);
+    }
+  }
+}
+
+void
+ZoneGrid::erase_cells(unsigned int zone)
+{
+  const Zone &z = zones_[zone];
+  Cell min = cell_of(z.x - z.radius, z.y - z.radius);
+  Cell max = cell_of(z.x + z.radius, z.y + z.radius);
+  for (int i = min.first; i <= max.first; ++i) {
+    for (int j = min.second; j <= max.second; ++j) {
+      std::vector<unsigned int> &cell = cells_[Cell(i, j)];
+      cell.erase(std::remove(cell.begin(), cell.end(), zone), cell.end());
+      if (cell.empty())  cells_.erase(Cell(i, j));
+    }
+  }
+}
+
+} // end namespace fawkes
@@ -0,0 +1,81 @@
+
+/***************************************************************************
+ *  zone_grid.h - Uniform grid index over spherical zones
+ *
+ *  Created: Sat Oct 17 11:42:50 2026
+ *  Copyright  2026  agent
+ *
+ ****************************************************************************/
+
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version. A runtime exception applies to
+ *  this software (see LICENSE.GPL_WRE file mentioned below for details).
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.GPL_WRE file in the doc directory.
+ */
+
+#ifndef __UTILS_GEOMETRY_ZONE_GRID_H_
+#define __UTILS_GEOMETRY_ZONE_GRID_H_
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace fawkes {
+#if 0 /* just to make Emacs auto-indent happy */
+}
+#endif
+
+class ZoneGrid
+{
+ public:
+  ZoneGrid(float cell_size);
+
+  unsigned int add_zone(float x, float y, float z, float radius);
+  void move_zone(unsigned int zone, float x, float y, float z);
+  void remove_zone(unsigned int zone);
+
+  void find(float x, float y, float z, std::vector<unsigned int> &zones) const;
+  bool find_nearest(float x, float y, float z, unsigned int &zone) const;
+
+  /** Get number of zones ever added (including removed ones).
+   * @return number of zone ids in use */
+  unsigned int size() const { return zones_.size(); }
+
+ private:
+  typedef std::pair<int, int> Cell;
+  /// @cond INTERNALS
+  struct CellHash {
+    std::size_t operator()(const Cell &c) const
+    { return ((std::size_t)(unsigned int)c.first * 73856093u) ^ (std::size_t)(unsigned int)c.second; }
+  };
+  /// @endcond
+
+  Cell cell_of(float x, float y) const;
+  void insert_cells(unsigned int zone);
+  void erase_cells(unsigned int zone);
+
+ private:
+  /// @cond INTERNALS
+  struct Zone {
+    float x, y, z;
+    float radius;
+    bool  active;
+  };
+  /// @endcond
+
+  float cell_size_;
+  std::vector<Zone> zones_;
+  std::unordered_map<Cell, std::vector<unsigned int>, CellHash> cells_;
+};
+
+} // end namespace fawkes
+
+#endif
@@ -0,0 +1,139 @@
+/***************************************************************************
+ *  string_template.cpp - String with precomputed substitution offsets
+ *
+ *  Created: Sat Oct 17 11:45:38 2026
+ *  Copyright  2026  agent
+ *
+ ****************************************************************************/
+
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version. A runtime exception applies to
+ *  this software (see LICENSE.GPL_WRE file mentioned below for details).
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.GPL_WRE file in the doc directory.
+ */
+
+#include <utils/misc/string_template.h>
+#include <core/exception.h>
+
+#include <algorithm>
+
+namespace fawkes {
+
+/** @class StringTemplate <utils/misc/string_template.h>
+ * String with precomputed substitution offsets.
+ * The text is searched for the placeholder patterns once when they are
+ * added. Filling the template then only appends the literal parts and
+ * the values into a single preallocated string, without searching,
+ * erasing or inserting.
+ *
+ * @author agent
+ */
+
+/** Empty constructor. */
+StringTemplate::StringTemplate()
+  : num_slots_(0)
+{
+}
+
+/** Constructor.
+ * @param text template text
+ */
+StringTemplate::StringTemplate(const std::string &text)
+  : text_(text), num_slots_(0)
+{
+}
+
+/** Add a placeholder.
+ * All occurrences of the pattern which do not overlap with occurrences
+ * of previously added placeholders become a new slot.
+ * @param pattern text to replace
+ * @param first_only only replace the first occurrence
+ * @return slot of the placeholder, index in the values passed to fill()
+ */
+unsigned int
+StringTemplate::add_placeholder(const std::string &pattern, bool first_only)
+{
+  unsigned int slot = num_slots_++;
+  if (pattern.empty())  return slot;
+
+  std::vector<Occurrence> found;
+  size_t pos = 0;
+  while ((pos = text_.find(pattern, pos)) != std::string::npos) {
+    bool overlaps = false;
+    for (const Occurrence &o : occurrences_) {
+      if (pos < o.offset + o.length && o.offset < pos + pattern.length()) {
+        overlaps = true;
+        break;
+      }
+    }
+    if (! overlaps) {
+      Occurrence o = {pos, pattern.length(), slot};
+      found.push_back(o);
+      if (first_only)  break;
+      pos += pattern.length();
+    } else {
+      pos += 1;
+    }
+  }
+
+  occurrences_.insert(occurrences_.end(), found.begin(), found.end());
+  std::sort(occurrences_.begin(), occurrences_.end(),
+	    [](const Occurrence &a, const Occurrence &b) { return a.offset < b.offset; });
+  return slot;
+}
+
+/** Get number of occurrences of a placeholder.
+ * @param slot slot of the placeholder
+ * @return number of places the placeholder is substituted at
+ */
+unsigned int
+StringTemplate::num_occurrences(unsigned int slot) const
+{
+  unsigned int n = 0;
+  for (const Occurrence &o : occurrences_) {
+    if (o.slot == slot)  ++n;
+  }
+  return n;
+}
+
+/** Fill template.
+ * @param values values for the placeholder slots
+ * @return template text with all placeholders substituted
+ * @exception Exception thrown if fewer values than slots are given
+ */
+std::string
+StringTemplate::fill(const std::vector<std::string> &values) const
+{
+  if (values.size() < num_slots_) {
+    throw Exception("StringTemplate: %zu values given for %u slots",
+		    values.size(), num_slots_);
+  }
+
+  size_t length = text_.length();
+  for (const Occurrence &o : occurrences_) {
+    length += values[o.slot].length();
+    length -= o.length;
+  }
+
+  std::string rv;
+  rv.reserve(length);
+  size_t pos = 0;
+  for (const Occurrence &o : occurrences_) {
+    rv.append(text_, pos, o.offset - pos);
+    rv.append(values[o.slot]);
+    pos = o.offset + o.length;
+  }
+  rv.append(text_, pos, std::string::npos);
+  return rv;
+}
+
+
+} // end namespace fawkes
@@ -0,0 +1,60 @@
+/***************************************************************************
+ *  string_template.h - String with precomputed substitution offsets
+ *
+ *  Created: Sat Oct 17 11:45:38 2026
+ *  Copyright  2026  agent
+ *
+ ****************************************************************************/
+
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version. A runtime exception applies to
+ *  this software (see LICENSE.GPL_WRE file mentioned below for details).
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.GPL_WRE file in the doc directory.
+ */
+
+#ifndef __UTILS_MISC_STRING_TEMPLATE_H_
+#define __UTILS_MISC_STRING_TEMPLATE_H_
+
+#include <string>
+#include <vector>
+
+namespace fawkes {
+
+
+class StringTemplate
+{
+ public:
+  StringTemplate();
+  StringTemplate(const std::string &text);
+
+  unsigned int add_placeholder(const std::string &pattern, bool first_only = false);
+  unsigned int num_occurrences(unsigned int slot) const;
+
+  std::string fill(const std::vector<std::string> &values) const;
+
+ private:
+  /// @cond INTERNALS
+  struct Occurrence {
+    size_t       offset;
+    size_t       length;
+    unsigned int slot;
+  };
+  /// @endcond
+
+  std::string              text_;
+  std::vector<Occurrence>  occurrences_;
+  unsigned int             num_slots_;
+};
+
+
+} // end namespace fawkes
+
+#endif
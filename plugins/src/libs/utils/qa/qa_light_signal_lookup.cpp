@@ -0,0 +1,150 @@
+/***************************************************************************
+ *  qa_light_signal_lookup.cpp - Nearest light signal lookup benchmark
+ *
+ *  Created: Sat Oct 17 11:55:54 2026
+ *  Copyright  2026  agent
+ *
+ ****************************************************************************/
+
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.GPL file in the doc directory.
+ */
+
+// Do not mention in API doc
+/// @cond QA
+
+#include <utils/geometry/zone_grid.h>
+
+#include <sys/time.h>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace fawkes;
+
+// as in plugins/light-signal-detection of the default config
+static const float RADIUS_DETECTION_AREA = 0.4;
+static const float SEARCH_AREA_REL_X     = 0.6;
+static const float SEARCH_AREA_REL_Y     = 0.4;
+
+struct Point { float x, y; };
+struct Robot { float x, y, yaw; };
+
+static double
+now()
+{
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec + tv.tv_usec / 1000000.;
+}
+
+static float
+frand(float min, float max)
+{
+  return min + (max - min) * (rand() / (float)RAND_MAX);
+}
+
+int
+main(int argc, char **argv)
+{
+  unsigned int num_robots = 6;
+  unsigned int num_machines = 32;
+  unsigned int num_msgs = 10000;
+  if (argc > 1)  num_robots = atoi(argv[1]);
+  if (argc > 2)  num_machines = atoi(argv[2]);
+  if (argc > 3)  num_msgs = atoi(argv[3]);
+
+  srand(42);
+  // light signal links by name, standing in for the entity lookup by name
+  std::vector<std::string> machine_names;
+  std::map<std::string, Point> links;
+  for (unsigned int i = 0; i < num_machines; ++i) {
+    char name[16];
+    snprintf(name, sizeof(name), "M%u", i + 1);
+    machine_names.push_back(name);
+    Point p = {frand(-7., 7.), frand(0., 8.)};
+    links[machine_names.back() + "::light_signals::link"] = p;
+  }
+
+  ZoneGrid grid(2 * RADIUS_DETECTION_AREA);
+  for (const std::string &name : machine_names) {
+    const Point &p = links[name + "::light_signals::link"];
+    grid.add_zone(p.x, p.y, 0., RADIUS_DETECTION_AREA);
+  }
+
+  // half of the robots look at a machine, the others somewhere on the field
+  std::vector<Robot> robots;
+  for (unsigned int i = 0; i < num_robots; ++i) {
+    Robot r = {frand(-7., 7.), frand(0., 8.), frand(-M_PI, M_PI)};
+    if (i % 2 == 0) {
+      const Point &p = links[machine_names[rand() % num_machines] + "::light_signals::link"];
+      r.x = p.x - (cos(r.yaw) * SEARCH_AREA_REL_X - sin(r.yaw) * SEARCH_AREA_REL_Y) + frand(-0.1, 0.1);
+      r.y = p.y - (sin(r.yaw) * SEARCH_AREA_REL_X + cos(r.yaw) * SEARCH_AREA_REL_Y) + frand(-0.1, 0.1);
+    }
+    robots.push_back(r);
+  }
+
+  // every robot looks up the light of every machine by name for every message
+  std::vector<int> linear_result(num_robots, -1);
+  double start = now();
+  for (unsigned int m = 0; m < num_msgs; ++m) {
+    for (unsigned int r = 0; r < num_robots; ++r) {
+      const Robot &robot = robots[r];
+      float look_x = robot.x + cos(robot.yaw) * SEARCH_AREA_REL_X - sin(robot.yaw) * SEARCH_AREA_REL_Y;
+      float look_y = robot.y + sin(robot.yaw) * SEARCH_AREA_REL_X + cos(robot.yaw) * SEARCH_AREA_REL_Y;
+      int nearest = -1;
+      float min_dist = 1000000;
+      for (unsigned int i = 0; i < num_machines; ++i) {
+        std::string light_link_name = machine_names[i] + "::light_signals::link";
+        const Point &p = links.find(light_link_name)->second;
+        float dist = sqrt((p.x - look_x) * (p.x - look_x) + (p.y - look_y) * (p.y - look_y));
+        if (dist < min_dist) {
+          min_dist = dist;
+          nearest = i;
+        }
+      }
+      linear_result[r] = min_dist < RADIUS_DETECTION_AREA ? nearest : -1;
+    }
+  }
+  double linear_time = now() - start;
+
+  std::vector<int> grid_result(num_robots, -1);
+  start = now();
+  for (unsigned int m = 0; m < num_msgs; ++m) {
+    for (unsigned int r = 0; r < num_robots; ++r) {
+      const Robot &robot = robots[r];
+      float look_x = robot.x + cos(robot.yaw) * SEARCH_AREA_REL_X - sin(robot.yaw) * SEARCH_AREA_REL_Y;
+      float look_y = robot.y + sin(robot.yaw) * SEARCH_AREA_REL_X + cos(robot.yaw) * SEARCH_AREA_REL_Y;
+      unsigned int zone;
+      grid_result[r] = grid.find_nearest(look_x, look_y, 0., zone) ? (int)zone : -1;
+    }
+  }
+  double grid_time = now() - start;
+
+  printf("%u robots, %u machines, %u MachineInfo messages\n",
+         num_robots, num_machines, num_msgs);
+  printf("  lookup by name: %10.3f ms  %8.3f us/message\n",
+         linear_time * 1000., linear_time * 1e6 / num_msgs);
+  printf("  zone grid:      %10.3f ms  %8.3f us/message\n",
+         grid_time * 1000., grid_time * 1e6 / num_msgs);
+
+  if (linear_result != grid_result) {
+    printf("Mismatch between lookup by name and zone grid\n");
+    return 1;
+  }
+  return 0;
+}
+
+/// @endcond
@@ -0,0 +1,155 @@
+/***************************************************************************
+ *  qa_point_cloud_packer.cpp - depthcam point cloud packing benchmark
+ *
+ *  Created: Sat Oct 17 11:59:08 2026
+ *  Copyright  2026  agent
+ *
+ ****************************************************************************/
+
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.GPL file in the doc directory.
+ */
+
+// Do not mention in API doc
+/// @cond QA
+
+#include <utils/geometry/point_cloud_packer.h>
+
+#include <sys/time.h>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace fawkes;
+
+// stands in for msgs::Vector3d, one heap allocated message per point
+struct Vector3d {
+  virtual ~Vector3d() {}
+  double x, y, z;
+  int cached_size;
+  unsigned int has_bits;
+};
+
+static double
+now()
+{
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec + tv.tv_usec / 1000000.;
+}
+
+// build the per point messages and serialize them like protobuf does,
+// tag and length of the sub message and tag and value of the fields
+static size_t
+per_point_messages(const float *pcd, unsigned int width, unsigned int height,
+                   std::string &buffer)
+{
+  std::vector<Vector3d *> points;
+  for (unsigned int i = 0; i < width * height * 4; i += 4) {
+    Vector3d *p = new Vector3d();
+    p->x = pcd[i + 0];
+    p->y = pcd[i + 1];
+    p->z = pcd[i + 2];
+    p->has_bits = 7;
+    p->cached_size = 27;
+    points.push_back(p);
+  }
+  buffer.clear();
+  for (Vector3d *p : points) {
+    char field[29];
+    field[0] = 0x0A;
+    field[1] = 27;
+    field[2] = 0x09;
+    memcpy(field + 3, &p->x, 8);
+    field[11] = 0x11;
+    memcpy(field + 12, &p->y, 8);
+    field[20] = 0x19;
+    memcpy(field + 21, &p->z, 8);
+    buffer.append(field, sizeof(field));
+    delete p;
+  }
+  return buffer.size();
+}
+
+static void
+report(const char *name, double time, unsigned int frames, size_t bytes, unsigned int points)
+{
+  printf("  %-22s %8.1f frames/s  %8.1f MB/s  %7u points/frame\n", name,
+         frames / time, bytes * frames / time / 1e6, points);
+}
+
+int
+main(int argc, char **argv)
+{
+  unsigned int width = 640;
+  unsigned int height = 480;
+  unsigned int frames = 100;
+  if (argc > 1)  frames = atoi(argv[1]);
+
+  // a wall two meters in front of the camera with a few pixels without hit
+  srand(42);
+  std::vector<float> pcd(width * height * 4);
+  for (unsigned int r = 0; r < height; ++r) {
+    for (unsigned int c = 0; c < width; ++c) {
+      float *p = &pcd[(r * width + c) * 4];
+      bool hit = rand() % 50 != 0;
+      p[0] = hit ? 2.f + (rand() % 100) / 1000.f : INFINITY;
+      p[1] = hit ? (c - width / 2.f) * 0.005f : INFINITY;
+      p[2] = hit ? (r - height / 2.f) * 0.005f : INFINITY;
+      unsigned int rgba = 0x808080FF;
+      memcpy(&p[3], &rgba, 4);
+    }
+  }
+
+  printf("%ux%u point cloud, %u frames\n", width, height, frames);
+
+  std::string buffer;
+  size_t bytes = 0;
+  double start = now();
+  for (unsigned int f = 0; f < frames; ++f) {
+    bytes = per_point_messages(&pcd[0], width, height, buffer);
+  }
+  report("message per point", now() - start, frames, bytes, width * height);
+
+  struct { const char *name; unsigned int stride; float voxel_size; bool color; } configs[] = {
+    {"packed xyzrgba",         1, 0.f,  true},
+    {"packed xyz",             1, 0.f,  false},
+    {"packed xyz, stride 2",   2, 0.f,  false},
+    {"packed xyz, voxel 2cm",  1, 0.02, false},
+  };
+  for (unsigned int i = 0; i < sizeof(configs) / sizeof(configs[0]); ++i) {
+    PointCloudPacker packer(configs[i].stride, configs[i].voxel_size, configs[i].color);
+    unsigned int points = 0;
+    start = now();
+    for (unsigned int f = 0; f < frames; ++f) {
+      points = packer.pack(&pcd[0], width, height, buffer);
+    }
+    report(configs[i].name, now() - start, frames, buffer.size(), points);
+
+    if (buffer.size() != (size_t)points * packer.point_step() ||
+        points != packer.width() * packer.height())
+    {
+      printf("Packed size does not match number of points\n");
+      return 1;
+    }
+    if (i == 0 && memcmp(buffer.data(), &pcd[0], buffer.size()) != 0) {
+      printf("Packed cloud differs from camera cloud\n");
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/// @endcond
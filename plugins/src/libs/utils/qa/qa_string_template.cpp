@@ -0,0 +1,132 @@
+
+/***************************************************************************
+ *  qa_string_template.cpp - workpiece SDF spawn rate benchmark
+ *
+ *  Created: Sat Oct 17 11:45:38 2026
+ *  Copyright  2026  agent
+ *
+ ****************************************************************************/
+
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.GPL file in the doc directory.
+ */
+
+// Do not mention in API doc
+/// @cond QA
+
+#include <utils/misc/string_template.h>
+
+#include <sys/time.h>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+using namespace fawkes;
+
+static const std::string OLD_NAME = "workpiece_base";
+static const std::string OLD_COLOR = "1.0 0.35 0.0 1";
+static const std::string PLUGIN = "<plugin name=\"Puck\" filename=\"libpuck.so\"/>";
+
+static double
+now()
+{
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec + tv.tv_usec / 1000000.;
+}
+
+static std::string
+plugin_with_color(const std::string &color)
+{
+  return "<plugin name=\"Puck\" filename=\"libpuck.so\"><baseColor>" + color + "</baseColor></plugin>";
+}
+
+// what Mps::spawn_puck did for every spawned workpiece
+static bool
+spawn_from_file(const char *sdf_path, const std::string &new_name, std::string &new_sdf)
+{
+  std::ifstream raw_sdf_file(sdf_path);
+  if (! raw_sdf_file.is_open())  return false;
+  std::string raw_sdf((std::istreambuf_iterator<char>(raw_sdf_file)),
+                      std::istreambuf_iterator<char>());
+  std::size_t name_pos = raw_sdf.find(OLD_NAME);
+  if (name_pos == std::string::npos)  return false;
+  new_sdf = raw_sdf.erase(name_pos, OLD_NAME.length()).insert(name_pos, new_name);
+  std::size_t color_pos;
+  while ((color_pos = new_sdf.find(OLD_COLOR)) != std::string::npos) {
+    new_sdf = new_sdf.erase(color_pos, OLD_COLOR.length()).insert(color_pos, "1.0 0.0 0.0 1");
+  }
+  std::size_t string_pos = new_sdf.find(PLUGIN);
+  new_sdf = new_sdf.erase(string_pos, PLUGIN.length())
+    .insert(string_pos, plugin_with_color("RED"));
+  return true;
+}
+
+int
+main(int argc, char **argv)
+{
+  std::string sdf_path;
+  if (argc > 1) {
+    sdf_path = argv[1];
+  } else if (getenv("GAZEBO_RCLL")) {
+    sdf_path = std::string(getenv("GAZEBO_RCLL")) + "/models/workpiece_base/model.sdf";
+  } else {
+    printf("Usage: %s <workpiece_base/model.sdf> [num_spawns]\n", argv[0]);
+    return 1;
+  }
+  unsigned int num_spawns = 10000;
+  if (argc > 2)  num_spawns = atoi(argv[2]);
+
+  std::string old_sdf;
+  unsigned long checksum = 0;
+  double start = now();
+  for (unsigned int i = 0; i < num_spawns; ++i) {
+    if (! spawn_from_file(sdf_path.c_str(), "puck_" + std::to_string(i), old_sdf)) {
+      printf("Cannot read %s\n", sdf_path.c_str());
+      return 1;
+    }
+    checksum += old_sdf.length();
+  }
+  double file_time = now() - start;
+
+  start = now();
+  std::ifstream raw_sdf_file(sdf_path.c_str());
+  StringTemplate sdf_template(std::string((std::istreambuf_iterator<char>(raw_sdf_file)),
+                                          std::istreambuf_iterator<char>()));
+  sdf_template.add_placeholder(OLD_NAME, /* first only */ true);
+  sdf_template.add_placeholder(OLD_COLOR);
+  sdf_template.add_placeholder(PLUGIN, /* first only */ true);
+  std::vector<std::string> values(3);
+  values[1] = "1.0 0.0 0.0 1";
+  values[2] = plugin_with_color("RED");
+  std::string new_sdf;
+  for (unsigned int i = 0; i < num_spawns; ++i) {
+    values[0] = "puck_" + std::to_string(i);
+    new_sdf = sdf_template.fill(values);
+    checksum -= new_sdf.length();
+  }
+  double template_time = now() - start;
+
+  printf("%u workpiece SDFs from %s\n", num_spawns, sdf_path.c_str());
+  printf("  read and substitute: %10.0f spawns/s\n", num_spawns / file_time);
+  printf("  cached template:     %10.0f spawns/s\n", num_spawns / template_time);
+
+  if (checksum != 0 || old_sdf != new_sdf) {
+    printf("Template result differs from substituted file\n");
+    return 1;
+  }
+  return 0;
+}
+
+/// @endcond
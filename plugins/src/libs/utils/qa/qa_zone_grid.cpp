@@ -0,0 +1,158 @@
+
+/***************************************************************************
+ *  qa_zone_grid.cpp - MPS zone hit-test benchmark
+ *
+ *  Created: Sat Oct 17 11:42:50 2026
+ *  Copyright  2026  agent
+ *
+ ****************************************************************************/
+
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.GPL file in the doc directory.
+ */
+
+// Do not mention in API doc
+/// @cond QA
+
+#include <utils/geometry/zone_grid.h>
+
+#include <sys/time.h>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace fawkes;
+
+// geometry as in plugins/mps of the default config
+static const float BELT_OFFSET_SIDE = 0.025;
+static const float BELT_LENGTH      = 0.35;
+static const float BELT_HEIGHT      = 0.92;
+static const float PUCK_SIZE        = 0.02;
+static const float DETECT_TOLERANCE = 0.06;
+
+// zones of one machine in the machine frame: long side, short side
+static const float ZONES[][2] = {
+  {0., 0.}, {0., -BELT_LENGTH}, {-0.1, 0.}, {-0.25, 0.}
+};
+static const unsigned int NUM_ZONES = sizeof(ZONES) / sizeof(ZONES[0]);
+
+struct Machine { float x, y, yaw; };
+struct Point { float x, y, z; };
+
+static double
+now()
+{
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec + tv.tv_usec / 1000000.;
+}
+
+// zone center as computed per call by Mps::get_puck_world_pose
+static void
+zone_center(const Machine &m, unsigned int zone, float &x, float &y)
+{
+  x = m.x + (BELT_OFFSET_SIDE + ZONES[zone][0]) * cos(m.yaw)
+    - ((BELT_LENGTH + ZONES[zone][1]) / 2 - PUCK_SIZE) * sin(m.yaw);
+  y = m.y + (BELT_OFFSET_SIDE + ZONES[zone][0]) * sin(m.yaw)
+    + ((BELT_LENGTH + ZONES[zone][1]) / 2 - PUCK_SIZE) * cos(m.yaw);
+}
+
+static float
+frand(float min, float max)
+{
+  return min + (max - min) * (rand() / (float)RAND_MAX);
+}
+
+int
+main(int argc, char **argv)
+{
+  unsigned int num_machines = 24;
+  unsigned int num_pucks = 100;
+  unsigned int num_rounds = 1000;
+  if (argc > 1)  num_machines = atoi(argv[1]);
+  if (argc > 2)  num_pucks = atoi(argv[2]);
+  if (argc > 3)  num_rounds = atoi(argv[3]);
+
+  srand(42);
+  std::vector<Machine> machines;
+  for (unsigned int i = 0; i < num_machines; ++i) {
+    Machine m = {frand(-7., 7.), frand(0., 8.), frand(-M_PI, M_PI)};
+    machines.push_back(m);
+  }
+
+  ZoneGrid grid(2 * DETECT_TOLERANCE);
+  for (const Machine &m : machines) {
+    for (unsigned int z = 0; z < NUM_ZONES; ++z) {
+      float x, y;
+      zone_center(m, z, x, y);
+      grid.add_zone(x, y, BELT_HEIGHT, DETECT_TOLERANCE);
+    }
+  }
+
+  // half of the pucks lie in some zone, the others somewhere on the field
+  std::vector<Point> pucks;
+  for (unsigned int i = 0; i < num_pucks; ++i) {
+    Point p = {frand(-7., 7.), frand(0., 8.), 0.02};
+    if (i % 2 == 0) {
+      zone_center(machines[rand() % num_machines], rand() % NUM_ZONES, p.x, p.y);
+      p.x += frand(-0.03, 0.03);
+      p.y += frand(-0.03, 0.03);
+      p.z = BELT_HEIGHT;
+    }
+    pucks.push_back(p);
+  }
+
+  // every machine tests every puck against each of its zones
+  unsigned long linear_hits = 0;
+  double start = now();
+  for (unsigned int r = 0; r < num_rounds; ++r) {
+    for (const Point &p : pucks) {
+      for (const Machine &m : machines) {
+        for (unsigned int z = 0; z < NUM_ZONES; ++z) {
+          float x, y;
+          zone_center(m, z, x, y);
+          float dx = p.x - x, dy = p.y - y, dz = p.z - BELT_HEIGHT;
+          if (sqrt(dx * dx + dy * dy + dz * dz) < DETECT_TOLERANCE)  ++linear_hits;
+        }
+      }
+    }
+  }
+  double linear_time = now() - start;
+
+  unsigned long grid_hits = 0;
+  std::vector<unsigned int> zones;
+  start = now();
+  for (unsigned int r = 0; r < num_rounds; ++r) {
+    for (const Point &p : pucks) {
+      grid.find(p.x, p.y, p.z, zones);
+      grid_hits += zones.size();
+    }
+  }
+  double grid_time = now() - start;
+
+  unsigned long classifications = (unsigned long)num_rounds * num_pucks;
+  printf("%u machines with %u zones, %u pucks, %u rounds\n",
+         num_machines, NUM_ZONES, num_pucks, num_rounds);
+  printf("  per machine test: %10.3f ms  %8.3f us/puck  %lu hits\n",
+         linear_time * 1000., linear_time * 1e6 / classifications, linear_hits);
+  printf("  zone grid:        %10.3f ms  %8.3f us/puck  %lu hits\n",
+         grid_time * 1000., grid_time * 1e6 / classifications, grid_hits);
+
+  if (linear_hits != grid_hits) {
+    printf("Mismatch between per machine test and zone grid\n");
+    return 1;
+  }
+  return 0;
+}
+
+/// @endcond
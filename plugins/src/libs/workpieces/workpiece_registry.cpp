@@ -0,0 +1,184 @@
+/***************************************************************************
+ *  workpiece_registry.cpp - Index of all workpiece models in the world
+ *
+ *  Created: Sat Oct 17 11:50:34 2026
+ *  Copyright  2026  agent
+ ****************************************************************************/
+
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.GPL file in the doc directory.
+ */
+
+#include <workpieces/workpiece_registry.h>
+
+using namespace gazebo;
+
+namespace gazebo_rcll {
+#if 0 /* just to make Emacs auto-indent happy */
+}
+#endif
+
+/** @class WorkpieceRegistry <workpieces/workpiece_registry.h>
+ * Index of the workpiece models in the world.
+ * Every workpiece registers itself when its plugin is loaded and gets a
+ * monotonic ID. Models can then be looked up by name or ID without
+ * searching through all models of the world. New workpieces get their
+ * names from next_name(), which counts up and never hands out a name
+ * twice, so spawn names neither collide nor depend on a random seed.
+ * The registry is shared by all plugins linking this library.
+ * @author agent
+ */
+
+WorkpieceRegistry * WorkpieceRegistry::registry_ = NULL;
+
+/** Constructor (Singleton) */
+WorkpieceRegistry::WorkpieceRegistry()
+{
+  next_id_ = 1;
+  next_name_ = 0;
+}
+
+/** Destructor. */
+WorkpieceRegistry::~WorkpieceRegistry()
+{
+}
+
+/** Getter for Singleton, creates the registry on first use
+ * @return pointer to singleton
+ */
+WorkpieceRegistry *
+WorkpieceRegistry::get_registry()
+{
+  if (!registry_) {
+    registry_ = new WorkpieceRegistry();
+  }
+  return registry_;
+}
+
+/** Reserve a name for a new workpiece.
+ * @return name "puck_<n>" which is neither registered nor reserved yet
+ */
+std::string
+WorkpieceRegistry::next_name()
+{
+  boost::mutex::scoped_lock lock(mutex_);
+  std::string name;
+  do {
+    name = "puck_" + std::to_string(next_name_++);
+  } while (ids_.find(name) != ids_.end() || reserved_.find(name) != reserved_.end());
+  reserved_.insert(name);
+  return name;
+}
+
+/** Register a workpiece model.
+ * @param model model of the workpiece
+ * @return ID of the workpiece, the existing one if the name is already registered
+ */
+unsigned int
+WorkpieceRegistry::add(physics::ModelPtr model)
+{
+  boost::mutex::scoped_lock lock(mutex_);
+  const std::string name = model->GetName();
+  reserved_.erase(name);
+  std::unordered_map<std::string, unsigned int>::iterator it = ids_.find(name);
+  if (it != ids_.end()) {
+    models_[it->second] = model;
+    return it->second;
+  }
+  unsigned int id = next_id_++;
+  ids_[name] = id;
+  models_[id] = model;
+  return id;
+}
+
+/** Unregister a workpiece model.
+ * @param name name of the workpiece
+ */
+void
+WorkpieceRegistry::remove(const std::string &name)
+{
+  boost::mutex::scoped_lock lock(mutex_);
+  std::unordered_map<std::string, unsigned int>::iterator it = ids_.find(name);
+  if (it != ids_.end()) {
+    models_.erase(it->second);
+    ids_.erase(it);
+  }
+}
+
+/** Look up a workpiece by name.
+ * @param name name of the workpiece model
+ * @return model, empty pointer if there is no such workpiece
+ */
+physics::ModelPtr
+WorkpieceRegistry::get(const std::string &name)
+{
+  boost::mutex::scoped_lock lock(mutex_);
+  std::unordered_map<std::string, unsigned int>::iterator it = ids_.find(name);
+  if (it == ids_.end()) {
+    return physics::ModelPtr();
+  }
+  return models_[it->second];
+}
+
+/** Look up a workpiece by ID.
+ * @param id ID returned by add()
+ * @return model, empty pointer if there is no such workpiece
+ */
+physics::ModelPtr
+WorkpieceRegistry::get(unsigned int id)
+{
+  boost::mutex::scoped_lock lock(mutex_);
+  std::unordered_map<unsigned int, physics::ModelPtr>::iterator it = models_.find(id);
+  if (it == models_.end()) {
+    return physics::ModelPtr();
+  }
+  return it->second;
+}
+
+/** Get the ID of a workpiece.
+ * @param name name of the workpiece model
+ * @return ID of the workpiece, 0 if it is not registered
+ */
+unsigned int
+WorkpieceRegistry::id(const std::string &name)
+{
+  boost::mutex::scoped_lock lock(mutex_);
+  std::unordered_map<std::string, unsigned int>::iterator it = ids_.find(name);
+  return it == ids_.end() ? 0 : it->second;
+}
+
+/** Get all registered workpieces.
+ * @return models of all workpieces
+ */
+physics::Model_V
+WorkpieceRegistry::models()
+{
+  boost::mutex::scoped_lock lock(mutex_);
+  physics::Model_V result;
+  result.reserve(models_.size());
+  for (const auto &entry : models_) {
+    result.push_back(entry.second);
+  }
+  return result;
+}
+
+/** Check if any workpiece is registered.
+ * @return true if no workpiece is registered
+ */
+bool
+WorkpieceRegistry::empty()
+{
+  boost::mutex::scoped_lock lock(mutex_);
+  return ids_.empty();
+}
+
+} // end namespace gazebo_rcll
@@ -0,0 +1,68 @@
+/***************************************************************************
+ *  workpiece_registry.h - Index of all workpiece models in the world
+ *
+ *  Created: Sat Oct 17 11:50:34 2026
+ *  Copyright  2026  agent
+ ****************************************************************************/
+
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.GPL file in the doc directory.
+ */
+
+#ifndef __WORKPIECES_WORKPIECE_REGISTRY_H_
+#define __WORKPIECES_WORKPIECE_REGISTRY_H_
+
+#include <boost/thread/mutex.hpp>
+#include <gazebo/physics/physics.hh>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace gazebo_rcll {
+#if 0 /* just to make Emacs auto-indent happy */
+}
+#endif
+
+class WorkpieceRegistry
+{
+ public:
+  static WorkpieceRegistry * get_registry();
+
+  std::string next_name();
+
+  unsigned int add(gazebo::physics::ModelPtr model);
+  void remove(const std::string &name);
+
+  gazebo::physics::ModelPtr get(const std::string &name);
+  gazebo::physics::ModelPtr get(unsigned int id);
+  unsigned int id(const std::string &name);
+  gazebo::physics::Model_V models();
+  bool empty();
+
+ private:
+  WorkpieceRegistry();
+  ~WorkpieceRegistry();
+
+  static WorkpieceRegistry *registry_;
+
+  boost::mutex mutex_;
+  unsigned int next_id_;
+  unsigned int next_name_;
+  std::unordered_map<std::string, unsigned int> ids_;
+  std::unordered_map<unsigned int, gazebo::physics::ModelPtr> models_;
+  /// names handed out by next_name() whose models are not registered yet
+  std::unordered_set<std::string> reserved_;
+};
+
+} // end namespace gazebo_rcll
+
+#endif
@@ -28,5 +28,10 @@
 #define PUCK_DETECTION_SEND_FREQUENCY 3.0
 #define FRONT_CAMERA_SEND_FREQUENCY 2.0
 
+///Only pucks closer than this are sent by the puck detection (0 sends all)
+#define PUCK_DETECTION_MAX_RANGE 0.0
+///Opening angle in front of the robot in which pucks are sent (0 sends all)
+#define PUCK_DETECTION_FOV 0.0
+
 #define ATTACH_PUCK_TO_GRIPPER_WHEN_TURNING true
 #define DISTANCE_GRIPPER_CENTER_ROBOTINO 0.23
@@ -76,26 +76,50 @@ void PuckDetection::send_puck_positions()
 {
   //send ground truth puck positions to fawkes
   //fawkes chooses which of them are too far away to detect
-  
+
+  //robot pose (the rotation is the same for all pucks)
+  math::Pose robot_pose = this->model->GetWorldPose();
+  double robot_x = robot_pose.pos.x;
+  double robot_y = robot_pose.pos.y;
+  double robot_ori = robot_pose.rot.GetAsEuler().z;
+  double cos_ori = cos(-robot_ori);
+  double sin_ori = sin(-robot_ori);
+
+  //transform all pucks into the robot frame in one pass over the table arrays
+  unsigned int num_pucks = table_->num_pucks();
+  const double *puck_x = table_->get_puck_x();
+  const double *puck_y = table_->get_puck_y();
+  rel_x_.resize(num_pucks);
+  rel_y_.resize(num_pucks);
+  double *rel_x = rel_x_.data();
+  double *rel_y = rel_y_.data();
+  for(unsigned int i = 0; i < num_pucks; i++)
+  {
+    double dx = puck_x[i] - robot_x;
+    double dy = puck_y[i] - robot_y;
+    rel_x[i] = dx * cos_ori - dy * sin_ori;
+    rel_y[i] = dx * sin_ori + dy * cos_ori;
+  }
+
   //build Protobuf Message
   llsf_msgs::PuckDetectionResult msg;
-  for(int i = 0; i < NUMBER_PUCKS; i++)
+  for(unsigned int i = 0; i < num_pucks; i++)
   {
-    llsf_msgs::Pose2D *pose = msg.add_positions();
-    //get puck from table
-    Puck puck = table_->get_puck(i);
+    //optionally leave out pucks the robot could not see anyway
+    if(PUCK_DETECTION_MAX_RANGE > 0.0 &&
+       rel_x[i] * rel_x[i] + rel_y[i] * rel_y[i] > PUCK_DETECTION_MAX_RANGE * PUCK_DETECTION_MAX_RANGE)
+    {
+      continue;
+    }
+    if(PUCK_DETECTION_FOV > 0.0 &&
+       fabs(atan2(rel_y[i], rel_x[i])) > PUCK_DETECTION_FOV / 2.0)
+    {
+      continue;
+    }
 
-    //set x, y (relative to robotino position)
-    double robot_x = this->model->GetWorldPose().pos.x;
-    double robot_y = this->model->GetWorldPose().pos.y;
-    double robot_ori = this->model->GetWorldPose().rot.GetAsEuler().z;
-    double rel_x = puck.x - robot_x;
-    double rel_y = puck.y - robot_y;
-    //apply transformation regarding robot orientation
-    double omni_x = rel_x * cos(-robot_ori) - rel_y * sin(-robot_ori);
-    double omni_y = rel_x *sin(-robot_ori) + rel_y * cos(-robot_ori);
-    pose->set_x(omni_x);
-    pose->set_y(omni_y);
+    llsf_msgs::Pose2D *pose = msg.add_positions();
+    pose->set_x(rel_x[i]);
+    pose->set_y(rel_y[i]);
 
     //set fake timestamp and ori
     pose->mutable_timestamp()->set_sec(0);
@@ -23,6 +23,7 @@
 #include <gazebo/common/common.hh>
 #include <stdio.h>
 #include <gazebo/transport/transport.hh>
+#include <vector>
 #include "simDevice.h"
 #include "../llsf/data_table.h"
 
@@ -56,5 +57,9 @@ namespace gazebo
 
     ///Table with the simulation data
     LlsfDataTable *table_;
+
+    ///puck positions relative to the robot, reused for each send
+    std::vector<double> rel_x_;
+    std::vector<double> rel_y_;
   };
 }
@@ -75,21 +75,23 @@ void PuckHolder::update()
     if(!puck_attached_)
     {
       //is a puck inside the gripper?
-      Puck closest;
+      int closest = -1;
       float min_dist = 100;
-      for(int p = 0; p < NUMBER_PUCKS; p++)
+      unsigned int num_pucks = table_->num_pucks();
+      const double *puck_x = table_->get_puck_x();
+      const double *puck_y = table_->get_puck_y();
+      for(unsigned int p = 0; p < num_pucks; p++)
       {
-	Puck puck = table_->get_puck(p);
-	double distance = sqrt((puck.x - center_x) * (puck.x - center_x) + (puck.y - center_y) * (puck.y - center_y));
+	double distance = sqrt((puck_x[p] - center_x) * (puck_x[p] - center_x) + (puck_y[p] - center_y) * (puck_y[p] - center_y));
 	if(distance < min_dist)
 	{
 	  min_dist = distance;
-	  closest = puck;
+	  closest = p;
 	}
       }
       if(min_dist < 0.04)
       {
-	puck_model_ = model->GetWorld()->GetEntity(closest.name_link.c_str())->GetParentModel();
+	puck_model_ = model->GetWorld()->GetEntity(table_->get_puck_name_link(closest))->GetParentModel();
 	puck_attached_ = true;
       }
     }
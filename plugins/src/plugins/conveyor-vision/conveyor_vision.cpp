@@ -29,6 +29,9 @@ using namespace gazebo;
 GZ_REGISTER_MODEL_PLUGIN(ConveyorVision)
 
 ConveyorVision::ConveyorVision()
+  : radius_detection_area_(config, "plugins/conveyor-vision/radius-detection-area"),
+    search_area_rel_x_(config, "plugins/conveyor-vision/search-area-rel-x"),
+    search_area_rel_y_(config, "plugins/conveyor-vision/search-area-rel-y")
 {
 }
 
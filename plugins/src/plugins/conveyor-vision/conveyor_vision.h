@@ -30,10 +30,10 @@
 #include <llsf_msgs/Pose3D.pb.h>
 #include <configurable/configurable.h>
 
-#define RADIUS_DETECTION_AREA config->get_float("plugins/conveyor-vision/radius-detection-area")
+#define RADIUS_DETECTION_AREA radius_detection_area_.get()
 //Search area where the robot is looking for the conveyor relative to the robots center
-#define SEARCH_AREA_REL_X config->get_float("plugins/conveyor-vision/search-area-rel-x")
-#define SEARCH_AREA_REL_Y config->get_float("plugins/conveyor-vision/search-area-rel-y")
+#define SEARCH_AREA_REL_X search_area_rel_x_.get()
+#define SEARCH_AREA_REL_Y search_area_rel_y_.get()
 //amount of pucks to listen for
 #define NUMBER_PUCKS number_pucks_
 //how far is the center of the belt hsifted from the machine center
@@ -85,6 +85,9 @@ namespace gazebo
     std::string name_;
 
     //config values:
+    gazebo_rcll::ConfigValueHandle<float> radius_detection_area_;
+    gazebo_rcll::ConfigValueHandle<float> search_area_rel_x_;
+    gazebo_rcll::ConfigValueHandle<float> search_area_rel_y_;
     int number_pucks_;
     //how far is the center of the belt hsifted from the machine center
     float belt_offset_side_;
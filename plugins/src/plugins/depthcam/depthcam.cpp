@@ -20,6 +20,7 @@
 
 #include <math.h>
 #include <fnmatch.h>
+#include <algorithm>
 #include <memory>
 #include <vector>
 
@@ -31,13 +32,20 @@ using namespace gazebo;
 GZ_REGISTER_SENSOR_PLUGIN(DepthCam)
 
 ///Constructor
-DepthCam::DepthCam() : SensorPlugin(), width_(0), height_(0), depth_(0), format_("")
+DepthCam::DepthCam() : SensorPlugin(), running_(false), width_(0), height_(0), depth_(0), format_("")
 {
 }
 ///Destructor
 DepthCam::~DepthCam()
 {
   printf("Destructing DepthCam Plugin!\n");
+  newRGBPointCloudConnection.reset();
+  if(publisher_thread_.joinable())
+  {
+    running_ = false;
+    wakeup_.notify_one();
+    publisher_thread_.join();
+  }
   parentSensor.reset();
   depthCamera.reset();
 }
@@ -76,9 +84,17 @@ void DepthCam::Load(sensors::SensorPtr _sensor, sdf::ElementPtr _sdf)
 
   //read config values
   pcl_topic_ = config->get_string("plugins/depthcam/topic-pcl");
+  packed_pcl_topic_ = config->get_string("plugins/depthcam/topic-packed-pcl");
+  packer_.set_stride(config->get_uint("plugins/depthcam/packed-stride"));
+  packer_.set_voxel_size(config->get_float("plugins/depthcam/packed-voxel-size"));
+  packer_.set_with_color(config->get_bool("plugins/depthcam/packed-with-color"));
+  queue_size_ = config->get_uint("plugins/depthcam/queue-size");
+  publish_rate_ = config->get_float("plugins/depthcam/publish-rate");
+  stats_interval_ = config->get_float("plugins/depthcam/stats-interval");
 
   //create publisher
   pcl_pub_ = node_->Advertise<msgs::PointCloud>(pcl_topic_.c_str());
+  packed_pcl_pub_ = node_->Advertise<gazsim_msgs::PackedPointCloud>(packed_pcl_topic_.c_str());
 
   //Adding those 2 lines enables, that the compiler uses the correct
   //one. Gazebo uses boost::shared_ptr up to version 5.2.1. Since
@@ -124,6 +140,10 @@ void DepthCam::Load(sensors::SensorPtr _sensor, sdf::ElementPtr _sdf)
   //     boost::bind(&DepthCam::OnNewImageFrame,
   //       this, _1, _2, _3, _4, _5));
 
+  ring_.reset(new FrameRing(queue_size_ + 1));
+  running_ = true;
+  publisher_thread_ = std::thread(&DepthCam::publisher_loop, this);
+
   parentSensor->SetActive(true);
 }
 
@@ -152,10 +172,148 @@ void DepthCam::OnNewRGBPointCloud(const float *_pcd,
   // printf("DepthCam: New Frame RGB\n");
   // printf("DepthCam: format: %s\n", _format.c_str());
 
+  //nothing is copied for topics without subscribers
+  if(!packed_pcl_pub_->HasConnections() && !pcl_pub_->HasConnections())
+  {
+    return;
+  }
+  stats_received_++;
+  Frame *frame = ring_->begin_write();
+  if(!frame)
+  {
+    return;
+  }
+  frame->points.assign(_pcd, _pcd + _width * _height * 4);
+  frame->width = _width;
+  frame->height = _height;
+  frame->received = std::chrono::steady_clock::now();
+  ring_->commit_write();
+  wakeup_.notify_one();
+}
+
+/**
+ * Loop of the publisher thread, publishes the queued frames
+ * If a publish rate is set, only the newest frame is published at each
+ * period and the older ones are skipped.
+ */
+void DepthCam::publisher_loop()
+{
+  using namespace std::chrono;
+  steady_clock::time_point next_publish = steady_clock::now();
+  steady_clock::time_point stats_start = steady_clock::now();
+  stats_received_ = 0;
+  stats_published_ = stats_skipped_ = 0;
+  stats_encode_time_ = stats_encode_time_max_ = stats_latency_ = 0.0;
+  stats_dropped_ = ring_->dropped();
+
+  while(running_)
+  {
+    {
+      std::unique_lock<std::mutex> lock(wakeup_mutex_);
+      wakeup_.wait_for(lock, milliseconds(100),
+                       [this]{ return !running_ || ring_->queued() > 0; });
+    }
+    steady_clock::time_point now = steady_clock::now();
+    if(stats_interval_ > 0 && duration<double>(now - stats_start).count() > stats_interval_)
+    {
+      print_stats(duration<double>(now - stats_start).count());
+      stats_start = now;
+    }
+    if(publish_rate_ > 0)
+    {
+      if(now < next_publish)
+      {
+        std::this_thread::sleep_until(std::min(next_publish, now + milliseconds(100)));
+        continue;
+      }
+      next_publish += duration_cast<steady_clock::duration>(duration<double>(1.0 / publish_rate_));
+      if(next_publish < now)
+      {
+        next_publish = now;
+      }
+    }
+
+    Frame *frame = ring_->begin_read();
+    if(!frame)
+    {
+      continue;
+    }
+    if(publish_rate_ > 0)
+    {
+      //only the newest frame is published in this period
+      while(ring_->queued() > 0)
+      {
+        ring_->end_read();
+        Frame *newer = ring_->begin_read();
+        if(!newer)
+        {
+          break;
+        }
+        frame = newer;
+        stats_skipped_++;
+      }
+    }
+
+    steady_clock::time_point encode_start = steady_clock::now();
+    if(packed_pcl_pub_->HasConnections())
+    {
+      publish_packed_cloud(*frame);
+    }
+    if(pcl_pub_->HasConnections())
+    {
+      publish_cloud(*frame);
+    }
+    steady_clock::time_point encode_end = steady_clock::now();
+    double encode_time = duration<double>(encode_end - encode_start).count();
+    stats_encode_time_ += encode_time;
+    stats_encode_time_max_ = std::max(stats_encode_time_max_, encode_time);
+    stats_latency_ += duration<double>(encode_end - frame->received).count();
+    stats_published_++;
+    ring_->end_read();
+  }
+}
+
+//prints the publisher counters since the last print
+void DepthCam::print_stats(double duration)
+{
+  uint64_t dropped = ring_->dropped();
+  uint64_t received = stats_received_.exchange(0);
+  printf("DepthCam %s: %.1f frames/s received, %.1f frames/s published, "
+         "%lu dropped, %lu skipped, encode %.2f ms (max %.2f ms), latency %.2f ms\n",
+         name_.c_str(), received / duration, stats_published_ / duration,
+         (unsigned long)(dropped - stats_dropped_), (unsigned long)stats_skipped_,
+         stats_published_ ? stats_encode_time_ * 1000.0 / stats_published_ : 0.0,
+         stats_encode_time_max_ * 1000.0,
+         stats_published_ ? stats_latency_ * 1000.0 / stats_published_ : 0.0);
+  stats_dropped_ = dropped;
+  stats_published_ = stats_skipped_ = 0;
+  stats_encode_time_ = stats_encode_time_max_ = stats_latency_ = 0.0;
+}
+
+/**
+ * Publish the cloud as one buffer of floats
+ */
+void DepthCam::publish_packed_cloud(const Frame &frame)
+{
+  packer_.pack(frame.points.data(), frame.width, frame.height, *packed_msg_.mutable_data());
+  packed_msg_.set_width(packer_.width());
+  packed_msg_.set_height(packer_.height());
+  packed_msg_.set_point_step(packer_.point_step());
+  packed_msg_.set_has_color(packer_.with_color());
+  packed_pcl_pub_->Publish(packed_msg_);
+}
+
+/**
+ * Publish the cloud with one message per point
+ */
+void DepthCam::publish_cloud(const Frame &frame)
+{
+  const float *_pcd = frame.points.data();
   //Construct point cloud message:
   msgs::PointCloud msg;
+  msg.mutable_points()->Reserve(frame.width * frame.height);
   //and fill with data
-  for(unsigned int i = 0; i < _width * _height * 4; i=i+4)
+  for(unsigned int i = 0; i < frame.width * frame.height * 4; i=i+4)
   {
     // printf("DepthCam: data: %f,%f,%f,%f\n", _pcd[i+0], _pcd[i+1], _pcd[i+2], _pcd[i+3]);
     msgs::Vector3d* point = msg.add_points();
@@ -23,12 +23,20 @@
 #include <gazebo/common/common.hh>
 #include <stdio.h>
 #include <gazebo/transport/transport.hh>
+#include <atomic>
+#include <condition_variable>
 #include <list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <gazebo/rendering/DepthCamera.hh>
 #include <gazebo/sensors/sensors.hh>
 #include <configurable/configurable.h>
+#include <gazsim_msgs/PackedPointCloud.pb.h>
+#include <utils/geometry/point_cloud_packer.h>
+#include "frame_ring.h"
 
 namespace gazebo
 {
@@ -65,12 +73,43 @@ namespace gazebo
     transport::NodePtr world_node_;
 
     transport::PublisherPtr pcl_pub_;
+    transport::PublisherPtr packed_pcl_pub_;
+
+    ///reused packed message, keeps its buffer between the frames
+    gazsim_msgs::PackedPointCloud packed_msg_;
+    fawkes::PointCloudPacker packer_;
+
+    void publish_packed_cloud(const Frame &frame);
+    void publish_cloud(const Frame &frame);
+
+    //the clouds are converted and published in an own thread, so slow
+    //subscribers or large frames do not stall the sensor update
+    std::unique_ptr<FrameRing> ring_;
+    std::thread publisher_thread_;
+    std::atomic<bool> running_;
+    std::mutex wakeup_mutex_;
+    std::condition_variable wakeup_;
+    void publisher_loop();
+    void print_stats(double duration);
+
+    //publisher counters, received by the sensor thread, the others by the publisher thread
+    std::atomic<uint64_t> stats_received_;
+    uint64_t stats_published_;
+    uint64_t stats_skipped_;
+    uint64_t stats_dropped_;
+    double stats_encode_time_;
+    double stats_encode_time_max_;
+    double stats_latency_;
 
     ///name of the communication channel and the sensor
     std::string name_;
 
     //config values:
     std::string pcl_topic_;
+    std::string packed_pcl_topic_;
+    unsigned int queue_size_;
+    double publish_rate_;
+    double stats_interval_;
 
     unsigned int width_, height_, depth_;
     std::string format_;
@@ -0,0 +1,98 @@
+/***************************************************************************
+ *  frame_ring.cpp - ring of point cloud frames between sensor and publisher
+ *
+ *  Created: Sat Oct 17 12:03:45 2026
+ *  Copyright  2026  agent
+ ****************************************************************************/
+
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.GPL file in the doc directory.
+ */
+
+#include "frame_ring.h"
+
+using namespace gazebo;
+
+/** Constructor
+ * @param size number of frames in the ring, at least 2
+ */
+FrameRing::FrameRing(unsigned int size)
+  : size_(size < 2 ? 2 : size), frames_(size_), busy_(new std::atomic<bool>[size_]),
+    head_(0), tail_(0), dropped_(0), reading_(0)
+{
+  for(unsigned int i = 0; i < size_; i++)
+  {
+    busy_[i] = false;
+  }
+}
+
+/** Get the frame to fill next (producer)
+ * Makes room by dropping the oldest frame if the ring is full.
+ * @return frame to fill, NULL if the consumer still reads it, then the new frame is dropped
+ */
+Frame * FrameRing::begin_write()
+{
+  uint64_t head = head_.load();
+  uint64_t tail = tail_.load();
+  //at most size - 1 frames are queued, the consumer may hold the frame before the tail
+  while(head - tail >= size_ - 1)
+  {
+    if(tail_.compare_exchange_weak(tail, tail + 1))
+    {
+      dropped_++;
+      tail++;
+    }
+  }
+  //the consumer took a frame a whole round ago and is still reading it
+  if(busy_[head % size_].load())
+  {
+    dropped_++;
+    return NULL;
+  }
+  return &frames_[head % size_];
+}
+
+/** Queue the frame filled after begin_write() (producer)
+ */
+void FrameRing::commit_write()
+{
+  head_++;
+}
+
+/** Take the oldest queued frame (consumer)
+ * @return frame to read until end_read(), NULL if no frame is queued
+ */
+Frame * FrameRing::begin_read()
+{
+  uint64_t tail = tail_.load();
+  while(tail != head_.load())
+  {
+    //mark the frame before taking it, so the producer does not overwrite it
+    uint64_t frame = tail;
+    busy_[frame % size_] = true;
+    if(tail_.compare_exchange_strong(tail, frame + 1))
+    {
+      reading_ = frame;
+      return &frames_[frame % size_];
+    }
+    //the producer dropped the frame meanwhile, tail is reloaded by the exchange
+    busy_[frame % size_] = false;
+  }
+  return NULL;
+}
+
+/** Release the frame taken by begin_read() (consumer)
+ */
+void FrameRing::end_read()
+{
+  busy_[reading_ % size_] = false;
+}
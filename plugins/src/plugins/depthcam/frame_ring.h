@@ -0,0 +1,80 @@
+/***************************************************************************
+ *  frame_ring.h - ring of point cloud frames between sensor and publisher
+ *
+ *  Created: Sat Oct 17 12:03:45 2026
+ *  Copyright  2026  agent
+ ****************************************************************************/
+
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.GPL file in the doc directory.
+ */
+
+#ifndef _FRAME_RING_HH_
+#define _FRAME_RING_HH_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace gazebo
+{
+  /// point cloud as delivered by the camera, four floats per point
+  struct Frame
+  {
+    std::vector<float> points;
+    unsigned int width;
+    unsigned int height;
+    ///when the sensor delivered the frame
+    std::chrono::steady_clock::time_point received;
+  };
+
+  /**
+   * Bounded ring of frames for one producer (the sensor callback) and one
+   * consumer (the publisher thread) without locks.
+   * When the ring is full the producer drops the oldest frame, so the
+   * consumer always gets the most recent frames.
+   * The frame buffers are reused, they only grow with the first frames.
+   */
+  class FrameRing
+  {
+  public:
+    FrameRing(unsigned int size);
+
+    Frame * begin_write();
+    void commit_write();
+
+    Frame * begin_read();
+    void end_read();
+
+    /** Get number of frames dropped because the ring was full.
+     * @return number of dropped frames */
+    uint64_t dropped() const { return dropped_.load(); }
+    /** Get number of queued frames.
+     * @return number of frames the consumer has not taken yet */
+    unsigned int queued() const { return head_.load() - tail_.load(); }
+
+  private:
+    unsigned int size_;
+    std::vector<Frame> frames_;
+    ///set by the consumer for the frame it reads
+    std::unique_ptr<std::atomic<bool>[]> busy_;
+    ///next frame written by the producer
+    std::atomic<uint64_t> head_;
+    ///oldest queued frame, advanced by the consumer and by the producer when dropping
+    std::atomic<uint64_t> tail_;
+    std::atomic<uint64_t> dropped_;
+    uint64_t reading_;
+  };
+}
+#endif
@@ -205,12 +205,10 @@ physics::ModelPtr Gripper::getNearestPuck() {
   physics::ModelPtr nearest;
   math::Pose gripperPose = getGripperLink()->GetWorldPose();
   double distance = DBL_MAX;
-  unsigned int modelCount = model_->GetWorld()->GetModelCount();
-  physics::ModelPtr tmp;
-  //filter returned list by name. Each puck starts with "Puck", e.g. "Puck0", "Puck1", ... and then find the nearest puck
-  for(unsigned int i = 0 ; i < modelCount; i++){
-    tmp = model_->GetWorld()->GetModel(i);
-    if (fnmatch("puck*",tmp->GetName().c_str(),FNM_CASEFOLD) == 0){
+  gazebo_rcll::WorkpieceRegistry *registry = gazebo_rcll::WorkpieceRegistry::get_registry();
+  if(!registry->empty()){
+    //only the registered workpieces have to be checked
+    for(physics::ModelPtr tmp : registry->models()){
       double tmpDistance = gripperPose.pos.Distance(tmp->GetWorldPose().pos);
       if(tmpDistance < distance){
 	distance = tmpDistance;
@@ -218,6 +216,21 @@ physics::ModelPtr Gripper::getNearestPuck() {
       }
     }
   }
+  else{
+    //worlds without workpiece plugins, filter all models by name. Each puck starts with "Puck", e.g. "Puck0", "Puck1", ... and then find the nearest puck
+    unsigned int modelCount = model_->GetWorld()->GetModelCount();
+    physics::ModelPtr tmp;
+    for(unsigned int i = 0 ; i < modelCount; i++){
+      tmp = model_->GetWorld()->GetModel(i);
+      if (fnmatch("puck*",tmp->GetName().c_str(),FNM_CASEFOLD) == 0){
+	double tmpDistance = gripperPose.pos.Distance(tmp->GetWorldPose().pos);
+	if(tmpDistance < distance){
+	  distance = tmpDistance;
+	  nearest = tmp;
+	}
+      }
+    }
+  }
   // std::cout << "Nearest puck: " << nearest->GetName() << std::endl;
   if(distance < RADIUS_GRAB_AREA){
     return nearest;
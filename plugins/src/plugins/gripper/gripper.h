@@ -30,6 +30,7 @@
 
 #include <boost/thread/mutex.hpp>
 #include <configurable/configurable.h>
+#include <workpieces/workpiece_registry.h>
 
 
 //config values
@@ -74,7 +74,8 @@ void LightControl::Load(physics::ModelPtr _parent, sdf::ElementPtr /*_sdf*/)
 						 /*number of lights*/ 3*12);
 
   //subscribe for light status msgs
-  light_msg_sub_ = node_->Subscribe(std::string(TOPIC_MACHINE_INFO), &LightControl::on_light_msg, this);
+  //the refbox comm publishes the info of each machine on its own topic
+  light_msg_sub_ = node_->Subscribe(std::string(TOPIC_MACHINE_INFO) + machine_name_, &LightControl::on_light_msg, this);
 
   world_ = model_->GetWorld();
   last_sent_time_ = world_->GetSimTime().Double();
@@ -123,7 +124,7 @@ void LightControl::on_light_msg(ConstMachineInfoPtr &msg)
   
   // find right machine by name
   for(int j = 0; j < msg->machines_size(); j++){
-    llsf_msgs::Machine machine_msg = msg->machines(j);
+    const llsf_msgs::Machine &machine_msg = msg->machines(j);
     if(machine_msg.name() == machine_name_){
       //set default values
       state_red_ = OFF;
@@ -132,7 +133,7 @@ void LightControl::on_light_msg(ConstMachineInfoPtr &msg)
     
       //go through all light specs
       for(int i = 0; i < machine_msg.lights_size(); i++){
-	llsf_msgs::LightSpec light_msg = machine_msg.lights(i);
+	const llsf_msgs::LightSpec &light_msg = machine_msg.lights(i);
 	LightState state = BLINK;
 	switch(light_msg.state())
 	{
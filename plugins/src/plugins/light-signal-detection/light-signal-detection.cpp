@@ -18,6 +18,7 @@
  */
 
 #include <math.h>
+#include <boost/thread/mutex.hpp>
 
 #include "light-signal-detection.h"
 #include <llsf_msgs/LightSignals.pb.h>
@@ -29,8 +30,36 @@ using namespace gazebo;
 // Register this plugin to make it available in the simulator
 GZ_REGISTER_MODEL_PLUGIN(LightSignalDetection)
 
+/// @cond INTERNALS
+/** Positions of the light signals of all machines, shared by all robots */
+struct LightSignalIndex
+{
+  LightSignalIndex() : grid(1.0), built(false), built_time(0.) {}
+
+  boost::mutex mutex;
+  /// zone around each light signal, the zone id indexes machines
+  fawkes::ZoneGrid grid;
+  std::vector<std::string> machines;
+  bool built;
+  double built_time;
+};
+
+static LightSignalIndex &
+light_signal_index()
+{
+  static LightSignalIndex index;
+  return index;
+}
+/// @endcond
+
 ///Constructor
 LightSignalDetection::LightSignalDetection()
+  : radius_detection_area_(config, "plugins/light-signal-detection/radius-detection-area"),
+    search_area_rel_x_(config, "plugins/light-signal-detection/search-area-rel-x"),
+    search_area_rel_y_(config, "plugins/light-signal-detection/search-area-rel-y"),
+    send_interval_(config, "plugins/light-signal-detection/send-interval"),
+    visibility_history_increase_per_second_(config, "plugins/light-signal-detection/visibility-history-increase-per-second"),
+    light_index_refresh_interval_(config, "plugins/light-signal-detection/light-index-refresh-interval")
 {
 }
 ///Destructor
@@ -146,28 +175,35 @@ void LightSignalDetection::on_light_msg(ConstMachineInfoPtr &msg)
     + sin(robot_pose_.rot.GetYaw()) * SEARCH_AREA_REL_X + cos(robot_pose_.rot.GetYaw()) * SEARCH_AREA_REL_Y;
 
   
-  // find mearest machine in front of the robot
-  int nearest_index = -1;
-  float min_dist = 1000000;
-  for(int i = 0; i < msg->machines_size(); i++){
-    llsf_msgs::Machine machine = msg->machines(i);
-    std::string machine_name = machine.name();
-    std::string light_link_name = machine_name + "::light_signals::link";
-    physics::EntityPtr light_entity = model_->GetWorld()->GetEntity(light_link_name.c_str());
-    if(light_entity == NULL){
-	    //printf("Light-Signal-Detection can't find machine with name %s!\n", machine_name.c_str());
-      return;
+  // find nearest machine in front of the robot
+  std::string nearest_name;
+  {
+    LightSignalIndex &index = light_signal_index();
+    boost::mutex::scoped_lock lock(index.mutex);
+    double time = model_->GetWorld()->GetSimTime().Double();
+    if(!index.built || time - index.built_time > LIGHT_INDEX_REFRESH_INTERVAL)
+    {
+      build_light_index(*msg);
     }
-    math::Pose light_pose = light_entity->GetWorldPose();
-    float dist = light_pose.pos.Distance(look_pos_x, look_pos_y, light_pose.pos.z);
-    if(dist < min_dist){
-      min_dist = dist;
-      nearest_index = i;
+    unsigned int zone;
+    if(index.grid.find_nearest(look_pos_x, look_pos_y, 0., zone))
+    {
+      nearest_name = index.machines[zone];
+    }
+  }
+  int nearest_index = -1;
+  if(!nearest_name.empty())
+  {
+    for(int i = 0; i < msg->machines_size(); i++){
+      if(msg->machines(i).name() == nearest_name){
+	nearest_index = i;
+	break;
+      }
     }
   }
 
   // get machine message of nearest machine
-  if(min_dist < RADIUS_DETECTION_AREA){
+  if(nearest_index >= 0){
     //check if the signal changed
     llsf_msgs::LightState old_red = state_red_;
     llsf_msgs::LightState old_yellow = state_yellow_;
@@ -192,7 +228,7 @@ void LightSignalDetection::on_light_msg(ConstMachineInfoPtr &msg)
   }
 }
 
-void LightSignalDetection::save_light_signal(llsf_msgs::Machine machine)
+void LightSignalDetection::save_light_signal(const llsf_msgs::Machine &machine)
 {
   //go through all light specs
   //set default values
@@ -200,7 +236,7 @@ void LightSignalDetection::save_light_signal(llsf_msgs::Machine machine)
   state_yellow_ = llsf_msgs::OFF;
   state_green_ = llsf_msgs::OFF;
   for(int i = 0; i < machine.lights_size(); i++){
-    llsf_msgs::LightSpec light_msg = machine.lights(i);
+    const llsf_msgs::LightSpec &light_msg = machine.lights(i);
     switch(light_msg.color())
     {
     case llsf_msgs::RED: state_red_ = light_msg.state(); break;
@@ -209,3 +245,27 @@ void LightSignalDetection::save_light_signal(llsf_msgs::Machine machine)
     }
   }
 }
+
+/** Look up the light signal positions of all machines and index them
+ * The shared index has to be locked by the caller.
+ * @param msg machine info listing all machines
+ */
+void LightSignalDetection::build_light_index(const llsf_msgs::MachineInfo &msg)
+{
+  LightSignalIndex &index = light_signal_index();
+  index.grid = fawkes::ZoneGrid(2 * RADIUS_DETECTION_AREA);
+  index.machines.clear();
+  for(const llsf_msgs::Machine &machine : msg.machines()){
+    std::string light_link_name = machine.name() + "::light_signals::link";
+    physics::EntityPtr light_entity = model_->GetWorld()->GetEntity(light_link_name);
+    if(light_entity == NULL){
+      //printf("Light-Signal-Detection can't find machine with name %s!\n", machine.name().c_str());
+      continue;
+    }
+    math::Pose light_pose = light_entity->GetWorldPose();
+    index.grid.add_zone(light_pose.pos.x, light_pose.pos.y, 0., RADIUS_DETECTION_AREA);
+    index.machines.push_back(machine.name());
+  }
+  index.built = true;
+  index.built_time = model_->GetWorld()->GetSimTime().Double();
+}
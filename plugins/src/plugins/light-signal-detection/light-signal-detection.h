@@ -28,6 +28,7 @@
 #include <string.h>
 #include <llsf_msgs/MachineInfo.pb.h>
 #include <configurable/configurable.h>
+#include <utils/geometry/zone_grid.h>
 
 
 //typedefs for sending the messages over the gazebo node
@@ -35,12 +36,14 @@ typedef const boost::shared_ptr<llsf_msgs::MachineInfo const> ConstMachineInfoPt
 
 //config values
 #define TOPIC_MACHINE_INFO config->get_string("plugins/light-signal-detection/topic-machine-info").c_str()
-#define RADIUS_DETECTION_AREA config->get_float("plugins/light-signal-detection/radius-detection-area")
+#define RADIUS_DETECTION_AREA radius_detection_area_.get()
 //Search area where the robot is looking for the signal relative to the robots center
-#define SEARCH_AREA_REL_X config->get_float("plugins/light-signal-detection/search-area-rel-x")
-#define SEARCH_AREA_REL_Y config->get_float("plugins/light-signal-detection/search-area-rel-y")
-#define SEND_INTERVAL config->get_float("plugins/light-signal-detection/send-interval")
-#define VISIBILITY_HISTORY_INCREASE_PER_SECOND config->get_int("plugins/light-signal-detection/visibility-history-increase-per-second") //usually camera frame rate
+#define SEARCH_AREA_REL_X search_area_rel_x_.get()
+#define SEARCH_AREA_REL_Y search_area_rel_y_.get()
+#define SEND_INTERVAL send_interval_.get()
+#define VISIBILITY_HISTORY_INCREASE_PER_SECOND visibility_history_increase_per_second_.get() //usually camera frame rate
+//interval in which the cached light signal positions are looked up again (machines are moved once by the placement)
+#define LIGHT_INDEX_REFRESH_INTERVAL light_index_refresh_interval_.get()
 
 
 namespace gazebo
@@ -85,7 +88,8 @@ namespace gazebo
     transport::SubscriberPtr light_msg_sub_;
     /// Handler for light status msg
     void on_light_msg(ConstMachineInfoPtr &msg);
-    void save_light_signal(llsf_msgs::Machine machine);
+    void save_light_signal(const llsf_msgs::Machine &machine);
+    void build_light_index(const llsf_msgs::MachineInfo &msg);
 
     //is the light currently detected?
     bool visible_;
@@ -98,5 +102,13 @@ namespace gazebo
 
     ///Publisher for Detected light signal
     transport::PublisherPtr light_signal_pub_;
+
+    //config values
+    gazebo_rcll::ConfigValueHandle<float> radius_detection_area_;
+    gazebo_rcll::ConfigValueHandle<float> search_area_rel_x_;
+    gazebo_rcll::ConfigValueHandle<float> search_area_rel_y_;
+    gazebo_rcll::ConfigValueHandle<float> send_interval_;
+    gazebo_rcll::ConfigValueHandle<int> visibility_history_increase_per_second_;
+    gazebo_rcll::ConfigValueHandle<float> light_index_refresh_interval_;
   };
 }
@@ -30,6 +30,9 @@ using namespace gazebo;
 
 LlsfRefboxCommPlugin::LlsfRefboxCommPlugin() : WorldPlugin()
 {
+  client_ = NULL;
+  message_register_ = NULL;
+
   // Resolve path to proto dirs by using the environmental variable $GAZEBO_RCLL
   const char * folder_path = ::getenv("GAZEBO_RCLL");
   if ( folder_path == 0 ) {
@@ -43,6 +46,8 @@ LlsfRefboxCommPlugin::LlsfRefboxCommPlugin() : WorldPlugin()
 
 LlsfRefboxCommPlugin::~LlsfRefboxCommPlugin()
 {
+  delete client_;
+  delete message_register_;
 }
 
 /** Initialization while loading the plugin
@@ -78,6 +83,13 @@ void LlsfRefboxCommPlugin::Load(physics::WorldPtr _world, sdf::ElementPtr _sdf)
 
   connected_ = false;
   connect_tries_ = 0;
+
+  //parse the proto files once, the register is kept for all reconnects
+  common::Time start = common::Time::GetWallTime();
+  message_register_ = new protobuf_comm::MessageRegister(proto_dirs_);
+  printf("LLSF-refbox-comm: Loaded message types in %.1f ms\n",
+         (common::Time::GetWallTime() - start).Double() * 1000.);
+
   printf("Trying to connect to refbox\n");
   //prepare client
   create_client();
@@ -141,6 +153,7 @@ LlsfRefboxCommPlugin::client_msg(uint16_t comp_id, uint16_t msg_type,
   if(msg->GetTypeName() == "llsf_msgs.MachineInfo")
   {
     machine_info_pub_->Publish(*msg);
+    publish_machine_infos(*std::static_pointer_cast<llsf_msgs::MachineInfo>(msg));
     return;
   }
   
@@ -158,10 +171,47 @@ LlsfRefboxCommPlugin::client_msg(uint16_t comp_id, uint16_t msg_type,
   // }
 }
 
+/** Split a MachineInfo into one message per machine
+ * Each machine is published on TOPIC_MACHINE_INFO + machine name, but only
+ * if it changed or was not sent for MACHINE_INFO_REFRESH seconds, so the
+ * machines only get their own entry and only when there is news.
+ * @param msg MachineInfo from the refbox
+ */
+void LlsfRefboxCommPlugin::publish_machine_infos(const llsf_msgs::MachineInfo &msg)
+{
+  double time = world_->GetSimTime().Double();
+  double refresh = MACHINE_INFO_REFRESH;
+  std::string serialized;
+  for(const llsf_msgs::Machine &machine : msg.machines())
+  {
+    machine.SerializeToString(&serialized);
+    std::map<std::string, MachineInfoTopic>::iterator it = machine_info_topics_.find(machine.name());
+    if(it == machine_info_topics_.end())
+    {
+      MachineInfoTopic topic;
+      topic.pub = node_->Advertise<llsf_msgs::MachineInfo>(std::string(TOPIC_MACHINE_INFO) + machine.name());
+      topic.last_sent_time = -refresh;
+      it = machine_info_topics_.insert(std::make_pair(machine.name(), topic)).first;
+    }
+    MachineInfoTopic &topic = it->second;
+    if(serialized == topic.last_sent && time - topic.last_sent_time < refresh)
+    {
+      continue;
+    }
+    llsf_msgs::MachineInfo machine_msg;
+    *machine_msg.add_machines() = machine;
+    topic.pub->Publish(machine_msg);
+    topic.last_sent.swap(serialized);
+    topic.last_sent_time = time;
+  }
+}
+
 void LlsfRefboxCommPlugin::create_client()
 {
-  //create message register with all messages to listen for
-  message_register_ = new protobuf_comm::MessageRegister(proto_dirs_);
+  common::Time start = common::Time::GetWallTime();
+
+  //replace the client of the last connection attempt
+  delete client_;
 
   //create client and register handlers
   client_ = new protobuf_comm::ProtobufStreamClient(message_register_);
@@ -172,6 +222,9 @@ void LlsfRefboxCommPlugin::create_client()
   		this, boost::asio::placeholders::error));
   client_->signal_received().connect(
     boost::bind(&LlsfRefboxCommPlugin::client_msg, this, _1, _2, _3));
+
+  printf("LLSF-refbox-comm: Created client in %.1f ms\n",
+         (common::Time::GetWallTime() - start).Double() * 1000.);
 }
 
 // void LlsfRefboxCommPlugin::on_puck_place_msg(ConstPlacePuckUnderMachinePtr &msg)
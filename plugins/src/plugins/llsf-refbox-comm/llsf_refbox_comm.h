@@ -31,6 +31,8 @@
 #include <gazsim_msgs/SimTime.pb.h>
 #include <llsf_msgs/OrderInfo.pb.h>
 #include <configurable/configurable.h>
+#include <map>
+#include <string>
 
 //typedefs for sending the messages over the gazebo node
 typedef const boost::shared_ptr<llsf_msgs::MachineInfo const> ConstMachineInfoPtr;
@@ -51,6 +53,8 @@ typedef const boost::shared_ptr<llsf_msgs::SetOrderDeliveredByColor const> Const
 //Max number of reconnect attempts (due to crash when tried to connect often)
 #define RECONNECT_ATTEMPTS config->get_int("plugins/llsf-refbox-comm/reconnect-attempts")
 #define TOPIC_MACHINE_INFO config->get_string("plugins/llsf-refbox-comm/topic-machine-info").c_str()
+//unchanged machine infos are republished on the per machine topics in this interval (in s)
+#define MACHINE_INFO_REFRESH config->get_float("plugins/llsf-refbox-comm/machine-info-refresh")
 #define TOPIC_GAME_STATE config->get_string("plugins/llsf-refbox-comm/topic-game-state").c_str()
 #define TOPIC_TIME config->get_string("plugins/llsf-refbox-comm/topic-time").c_str()
 #define TOPIC_SET_GAME_STATE config->get_string("plugins/llsf-refbox-comm/topic-set-game-state").c_str()
@@ -99,6 +103,7 @@ namespace gazebo
 
     protobuf_comm::ProtobufStreamClient *client_;
     std::vector<std::string> proto_dirs_;
+    ///message types to listen for, loaded once and shared by all clients
     protobuf_comm::MessageRegister      *message_register_;
 
     //Publisher and subscriber for the connection to gazebo
@@ -131,6 +136,18 @@ namespace gazebo
     int connect_tries_;
 
     void create_client();
+
+    void publish_machine_infos(const llsf_msgs::MachineInfo &msg);
+
+    /// last published state of a machine on its own topic
+    struct MachineInfoTopic
+    {
+      gazebo::transport::PublisherPtr pub;
+      std::string last_sent;
+      double last_sent_time;
+    };
+    /// per machine topics by machine name
+    std::map<std::string, MachineInfoTopic> machine_info_topics_;
     
   };
   GZ_REGISTER_WORLD_PLUGIN(LlsfRefboxCommPlugin)
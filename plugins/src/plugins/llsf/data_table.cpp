@@ -25,9 +25,9 @@
 #include <gazebo/physics/physics.hh>
 #include <gazebo/common/common.hh>
 #include <stdio.h>
+#include <stdlib.h>
 #include <gazebo/transport/transport.hh>
 #include <stddef.h>
-#include <sstream>
 
 #include "data_table.h"
 #include "refbox_comm.h"
@@ -46,6 +46,13 @@ LlsfDataTable::LlsfDataTable(physics::WorldPtr world, transport::NodePtr gazebo_
   //read out machine positions and orientation from world
   init_table();
 
+  machine_signals_changed_ = true;
+
+  //the cached puck links are refreshed when models are added or removed
+  entities_changed_ = true;
+  model_info_sub_ = gazebo_node->Subscribe("~/model/info", &LlsfDataTable::on_model_info_msg, this);
+  request_sub_ = gazebo_node->Subscribe("~/request", &LlsfDataTable::on_request_msg, this);
+
   //initialize refbox communication
   refbox_comm_ = new RefboxComm(this, gazebo_node);
 }
@@ -90,46 +97,221 @@ void LlsfDataTable::finalize()
  * @param name Name of the machine (enum)
  * @return machine data
  */
-Machine LlsfDataTable::get_machine(MachineName name)
+const Machine & LlsfDataTable::get_machine(MachineName name) const
 {
   return machines_[name];
 }
 
 /** Getter for machine data
  * @param machine Name of the machine (string)
- * @return machine data
+ * @return machine data, the empty default entry if there is no such machine
  */
-Machine LlsfDataTable::get_machine(std::string machine)
+const Machine & LlsfDataTable::get_machine(const std::string &machine) const
 {
-  for(int i = M1; i <= R2; i++)
+  std::unordered_map<std::string, MachineName>::const_iterator it = machine_index_.find(machine);
+  if(it == machine_index_.end())
   {
-    //is it the right machine?
-    if(machines_[i].name_string.compare(machine) == 0)
-    {
-      return machines_[i];
-    }
+    return machines_[NONE];
   }
-  //default  
-  return machines_[0];
+  return machines_[it->second];
 }
 
 /** Getter for machine data (all machines)
- * @return pointer to machine data
+ * @return pointer to machine data, indexed by MachineName
  */
 Machine* LlsfDataTable::get_machines()
 {
-  return machines_;
+  return machines_.data();
+}
+
+/** Getter for the number of machines
+ * @return number of machines in get_machines()
+ */
+unsigned int LlsfDataTable::num_machines() const
+{
+  //the last entry is the empty default for NONE
+  return machines_.size() - 1;
 }
 
 /** Getter for puck data
+ * Copies all fields of the puck, use the array getters in loops.
  * @param number number of the puck
  * @return puck data
  */
-Puck LlsfDataTable::get_puck(int number)
+Puck LlsfDataTable::get_puck(int number) const
+{
+  Puck puck;
+  puck.number = number;
+  puck.name_link = puck_name_link_[number];
+  puck.x = puck_x_[number];
+  puck.y = puck_y_[number];
+  puck.under_rfid = puck_under_rfid_[number];
+  puck.in_machine_area = puck_in_machine_area_[number];
+  puck.state = puck_state_[number];
+  return puck;
+}
+
+/** Getter for the number of pucks
+ * @return number of entries in the puck arrays
+ */
+unsigned int LlsfDataTable::num_pucks() const
+{
+  return puck_x_.size();
+}
+
+/** Getter for the x coordinates of all pucks
+ * @return array of num_pucks() entries indexed by puck number
+ */
+const double * LlsfDataTable::get_puck_x() const
+{
+  return puck_x_.data();
+}
+
+/** Getter for the y coordinates of all pucks
+ * @return array of num_pucks() entries indexed by puck number
+ */
+const double * LlsfDataTable::get_puck_y() const
+{
+  return puck_y_.data();
+}
+
+/** Getter for the machines all pucks are under
+ * @return array of num_pucks() entries indexed by puck number
+ */
+const MachineName * LlsfDataTable::get_pucks_under_rfid() const
 {
-  return pucks_[number]; //assuming the pucks numbers start at 0
+  return puck_under_rfid_.data();
 }
 
+/** Getter for the states of all pucks
+ * @return array of num_pucks() entries indexed by puck number
+ */
+const llsf_msgs::PuckState * LlsfDataTable::get_puck_states() const
+{
+  return puck_state_.data();
+}
+
+/** Getter for the link name of a puck
+ * @param number number of the puck
+ * @return name of the puck link in the gazebo world
+ */
+const std::string & LlsfDataTable::get_puck_name_link(int number) const
+{
+  return puck_name_link_[number];
+}
+
+/** Getter for the link of a puck in the gazebo world
+ * The link is looked up once and cached until models are added or removed.
+ * @param number number of the puck
+ * @return puck link, empty if the puck does not exist in the world
+ */
+physics::EntityPtr LlsfDataTable::get_puck_entity(int number)
+{
+  return puck_entity_[number];
+}
+
+/** Resolve the links of all pucks again if models were added or removed
+ * since the last call. Has to be called from the world update thread.
+ */
+void LlsfDataTable::refresh_puck_entities()
+{
+  std::set<std::string> deleted;
+  {
+    boost::mutex::scoped_lock lock(entity_mutex_);
+    if(!entities_changed_)
+    {
+      return;
+    }
+    entities_changed_ = false;
+    deleted = deleted_models_;
+  }
+
+  for(unsigned int p = 0; p < puck_entity_.size(); p++)
+  {
+    const std::string &name_link = puck_name_link_[p];
+    //a model requested to be deleted might still be in the world
+    if(deleted.count(name_link.substr(0, name_link.find("::"))))
+    {
+      puck_entity_[p].reset();
+      continue;
+    }
+    if(!puck_entity_[p])
+    {
+      puck_entity_[p] = world_->GetEntity(name_link);
+    }
+    if(!puck_entity_[p] && !puck_missing_reported_[p])
+    {
+      printf("Can not find puck with index %d\n", p);
+      puck_missing_reported_[p] = true;
+    }
+    else if(puck_entity_[p])
+    {
+      puck_missing_reported_[p] = false;
+    }
+  }
+}
+
+void LlsfDataTable::on_model_info_msg(ConstModelPtr &msg)
+{
+  boost::mutex::scoped_lock lock(entity_mutex_);
+  deleted_models_.erase(msg->name());
+  entities_changed_ = true;
+}
+
+void LlsfDataTable::on_request_msg(ConstRequestPtr &msg)
+{
+  if(msg->request() != "entity_delete")
+  {
+    return;
+  }
+  boost::mutex::scoped_lock lock(entity_mutex_);
+  deleted_models_.insert(msg->data());
+  entities_changed_ = true;
+}
+
+/** Getter for the light signals of all machines
+ * The message is shared by the machine vision of all robots and only
+ * rebuilt after a light changed. Has to be called from the world update thread.
+ * @return light signals with positions of all machines
+ */
+const llsf_msgs::AllMachineSignals & LlsfDataTable::get_machine_signals()
+{
+  //clear before rebuilding, so a change during the rebuild is not lost
+  if(!machine_signals_changed_.exchange(false))
+  {
+    return machine_signals_;
+  }
+
+  machine_signals_.Clear();
+  for(int i = M1; i != R2; i++)
+  {
+    const Machine &machine = machines_[i];
+    llsf_msgs::MachineSignal *machine_signal = machine_signals_.add_machines();
+    machine_signal->set_name(machine.name_link);
+    //set lights
+    LightState states[3] = {machine.red, machine.yellow, machine.green};
+    llsf_msgs::LightColor colors[3] = {llsf_msgs::RED, llsf_msgs::YELLOW, llsf_msgs::GREEN};
+    for(int l = 0; l < 3; l++)
+    {
+      llsf_msgs::LightSpec *light = machine_signal->add_lights();
+      light->set_color(colors[l]);
+      switch(states[l])
+      {
+      case ON: light->set_state(llsf_msgs::ON); break;
+      case BLINK: light->set_state(llsf_msgs::BLINK); break;
+      default: light->set_state(llsf_msgs::OFF); break;
+      }
+    }
+    //set position
+    machine_signal->mutable_pose()->set_x(machine.x);
+    machine_signal->mutable_pose()->set_y(machine.y);
+    machine_signal->mutable_pose()->set_ori(machine.ori);
+    //set timestamp of position (only needed to successfully compile)
+    machine_signal->mutable_pose()->mutable_timestamp()->set_sec(0);
+    machine_signal->mutable_pose()->mutable_timestamp()->set_nsec(0);
+  }
+  return machine_signals_;
+}
 
 /** Setter for light state
  * @param machine Name of the machine (enum)
@@ -140,9 +322,14 @@ Puck LlsfDataTable::get_puck(int number)
 void LlsfDataTable::set_light_state(MachineName machine, LightState red, 
 				    LightState yellow, LightState green)
 {
-  machines_[machine].red = red;
-  machines_[machine].yellow = yellow;
-  machines_[machine].green = green;
+  if(machines_[machine].red != red || machines_[machine].yellow != yellow ||
+     machines_[machine].green != green)
+  {
+    machines_[machine].red = red;
+    machines_[machine].yellow = yellow;
+    machines_[machine].green = green;
+    machine_signals_changed_ = true;
+  }
 }
 
 /** Setter for light state
@@ -151,17 +338,13 @@ void LlsfDataTable::set_light_state(MachineName machine, LightState red,
  * @param yellow state of yellow light
  * @param green state of green light
  */
-void LlsfDataTable::set_light_state(std::string machine, LightState red,
+void LlsfDataTable::set_light_state(const std::string &machine, LightState red,
 		     LightState yellow, LightState green)
 {
-  for(int i = M1; i <= R2; i++)
+  std::unordered_map<std::string, MachineName>::const_iterator it = machine_index_.find(machine);
+  if(it != machine_index_.end())
   {
-    //is it the right machine?
-    if(machines_[i].name_string.find(machine) == 0)
-    {
-      set_light_state(machines_[i].name, red, yellow, green);
-      return;
-    }
+    set_light_state(it->second, red, yellow, green);
   }
 }
 
@@ -169,16 +352,12 @@ void LlsfDataTable::set_light_state(std::string machine, LightState red,
  * @param machine Name of the machine (string)
  * @param team name of the team
  */
-void LlsfDataTable::set_machine_team(std::string machine, Team team)
+void LlsfDataTable::set_machine_team(const std::string &machine, Team team)
 {
-  for(int i = M1; i <= R2; i++)
+  std::unordered_map<std::string, MachineName>::const_iterator it = machine_index_.find(machine);
+  if(it != machine_index_.end())
   {
-    //is it the right machine?
-    if(machines_[i].name_string.find(machine) == 0)
-    {
-      machines_[i].team = team;
-      return;
-    }
+    machines_[it->second].team = team;
   }
 }
 
@@ -189,8 +368,8 @@ void LlsfDataTable::set_machine_team(std::string machine, Team team)
  */
 void LlsfDataTable::set_puck_pos(int puck, double x, double y)
 {
-  pucks_[puck].x = x;
-  pucks_[puck].y = y;
+  puck_x_[puck] = x;
+  puck_y_[puck] = y;
 }
 
 /** Mark a puck as placed under a machine
@@ -199,7 +378,7 @@ void LlsfDataTable::set_puck_pos(int puck, double x, double y)
  */
 void LlsfDataTable::set_puck_under_rfid(int puck, MachineName machine)
 {
-  pucks_[puck].under_rfid = machine;
+  puck_under_rfid_[puck] = machine;
   //inform refbox
   refbox_comm_->send_puck_placed_under_rfid(puck, machines_[machine]);
 }
@@ -210,7 +389,7 @@ void LlsfDataTable::set_puck_under_rfid(int puck, MachineName machine)
  */
 void LlsfDataTable::remove_puck_under_rfid(int puck, MachineName machine)
 {
-  pucks_[puck].under_rfid = NONE;
+  puck_under_rfid_[puck] = NONE;
   //inform refbox
   refbox_comm_->send_remove_puck_from_machine(puck, machines_[machine]);
 }
@@ -221,7 +400,7 @@ void LlsfDataTable::remove_puck_under_rfid(int puck, MachineName machine)
  */
 void LlsfDataTable::set_puck_in_machine_area(int puck, MachineName machine)
 {
-  pucks_[puck].in_machine_area = machine;
+  puck_in_machine_area_[puck] = machine;
   //TODO: inform refbox if a puck leaves a machine area
 }
 
@@ -231,11 +410,35 @@ void LlsfDataTable::set_puck_in_machine_area(int puck, MachineName machine)
  */
 void LlsfDataTable::set_puck_state(int puck, llsf_msgs::PuckState state)
 {
-  pucks_[puck].state = state;
+  boost::mutex::scoped_lock lock(puck_mutex_);
+  if(puck < 0 || (unsigned int) puck >= puck_state_.size())
+  {
+    return;
+  }
+  puck_state_[puck] = state;
+}
+
+/** Add a puck to the table
+ * The puck gets the next free number. Has to be called from the world
+ * update thread, like all other users of the puck arrays.
+ * @param name_link name of the link of the puck in the gazebo world
+ * @return number of the new puck
+ */
+int LlsfDataTable::add_puck(const std::string &name_link)
+{
+  int number = num_pucks();
+  init_puck(number, name_link);
+  return number;
 }
 
 void LlsfDataTable::init_table()
 {
+  machines_.resize(NONE + 1);
+  machines_[NONE].name = NONE;
+  machines_[NONE].x = machines_[NONE].y = machines_[NONE].ori = 0.0;
+  machines_[NONE].red = machines_[NONE].yellow = machines_[NONE].green = OFF;
+  machines_[NONE].team = NIL;
+
   init_machine(M1, "llsf_field::M1::machine_link", "M1");
   init_machine(M2, "llsf_field::M2::machine_link", "M2");
   init_machine(M3, "llsf_field::M3::machine_link", "M3");
@@ -269,11 +472,17 @@ void LlsfDataTable::init_table()
   init_machine(R1, "llsf_field::R1::machine_link", "R1");
   init_machine(R2, "llsf_field::R2::machine_link", "R2");
 
-  for(int i = 0; i < NUMBER_PUCKS; i++)
+  //register the pucks of the world, PuckN gets number N as known by the refbox
+  physics::Model_V models = world_->GetModels();
+  for(const physics::ModelPtr &model : models)
   {
-    std::ostringstream ss;
-    ss << "Puck" << i << "::cylinder";
-    init_puck(i, ss.str().c_str());
+    const std::string &name = model->GetName();
+    if(name.compare(0, 4, "Puck") != 0 || name.size() == 4 ||
+       name.find_first_not_of("0123456789", 4) != std::string::npos)
+    {
+      continue;
+    }
+    init_puck(atoi(name.c_str() + 4), name + "::cylinder");
   }
 }
 
@@ -282,6 +491,7 @@ void LlsfDataTable::init_machine(MachineName number, std::string name_link, std:
   machines_[number].name = number;
   machines_[number].name_link = name_link;
   machines_[number].name_string = name_string;
+  machine_index_[name_string] = number;
   if(!world_->GetEntity(name_link))
   {
     printf("Can not find machine %s\n", name_link.c_str());
@@ -298,9 +508,24 @@ void LlsfDataTable::init_machine(MachineName number, std::string name_link, std:
 
 void LlsfDataTable::init_puck(int number, std::string name)
 {
-  pucks_[number].number = number;
-  pucks_[number].name_link = name;
-  pucks_[number].under_rfid = NONE;
-  pucks_[number].in_machine_area = NONE;
-  pucks_[number].state = llsf_msgs::S0;
+  boost::mutex::scoped_lock lock(puck_mutex_);
+  if((unsigned int) number >= puck_x_.size())
+  {
+    puck_name_link_.resize(number + 1);
+    puck_x_.resize(number + 1, 0.0);
+    puck_y_.resize(number + 1, 0.0);
+    puck_under_rfid_.resize(number + 1, NONE);
+    puck_in_machine_area_.resize(number + 1, NONE);
+    puck_state_.resize(number + 1, llsf_msgs::S0);
+    puck_entity_.resize(number + 1);
+    puck_missing_reported_.resize(number + 1, false);
+  }
+  puck_name_link_[number] = name;
+  puck_under_rfid_[number] = NONE;
+  puck_in_machine_area_[number] = NONE;
+  puck_state_[number] = llsf_msgs::S0;
+
+  //resolve the link of the new puck in the next refresh
+  boost::mutex::scoped_lock entity_lock(entity_mutex_);
+  entities_changed_ = true;
 }
@@ -25,12 +25,15 @@
 
 
 #include "refbox_comm.h"
+#include <boost/thread/mutex.hpp>
+#include <atomic>
 #include <string.h>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
 #include <llsf_msgs/PuckInfo.pb.h>
-
-
-#define NUMBER_MACHINES 32
-#define NUMBER_PUCKS 44
+#include <llsf_msgs/LightSignals.pb.h>
 
 namespace gazebo
 {
@@ -121,6 +124,8 @@ namespace gazebo
    } Machine;
 
   /** Strunct for puck data
+   * (assembled by LlsfDataTable::get_puck(), the table stores the fields
+   * in separate arrays)
    */
   typedef struct Puck
   {
@@ -168,22 +173,33 @@ namespace gazebo
 
 
     //Getter
-    Machine get_machine(MachineName name);
-    Machine get_machine(std::string name);
+    const Machine & get_machine(MachineName name) const;
+    const Machine & get_machine(const std::string &name) const;
     Machine* get_machines();
-    Puck get_puck(int number);
+    unsigned int num_machines() const;
+    Puck get_puck(int number) const;
+    unsigned int num_pucks() const;
+    const double * get_puck_x() const;
+    const double * get_puck_y() const;
+    const MachineName * get_pucks_under_rfid() const;
+    const llsf_msgs::PuckState * get_puck_states() const;
+    const std::string & get_puck_name_link(int number) const;
+    physics::EntityPtr get_puck_entity(int number);
+    const llsf_msgs::AllMachineSignals & get_machine_signals();
+    void refresh_puck_entities();
 
     // Setter
     void set_light_state(MachineName machine, LightState red,
 			 LightState yellow, LightState green);
-    void set_light_state(std::string machine, LightState red,
+    void set_light_state(const std::string &machine, LightState red,
 			 LightState yellow, LightState green);
-    void set_machine_team(std::string machine, Team team);
+    void set_machine_team(const std::string &machine, Team team);
     void set_puck_pos(int puck, double x, double y);
     void set_puck_under_rfid(int puck, MachineName machine);
     void remove_puck_under_rfid(int puck, MachineName machine);
     void set_puck_in_machine_area(int puck, MachineName machine);
     void set_puck_state(int puck, llsf_msgs::PuckState state);
+    int add_puck(const std::string &name_link);
 
   private:
     ///Provides communication to the refbox
@@ -193,8 +209,42 @@ namespace gazebo
 
 
     //data
-    Machine machines_[33]; //[MX] gets machine X, except for [0]
-    Puck pucks_[NUMBER_PUCKS];
+    ///machines indexed by MachineName, [NONE] is an empty default
+    std::vector<Machine> machines_;
+    ///index of each machine by its name (string)
+    std::unordered_map<std::string, MachineName> machine_index_;
+
+    ///puck data, one entry per puck number in each array
+    std::vector<std::string> puck_name_link_;
+    std::vector<double> puck_x_;
+    std::vector<double> puck_y_;
+    std::vector<MachineName> puck_under_rfid_;
+    std::vector<MachineName> puck_in_machine_area_;
+    std::vector<llsf_msgs::PuckState> puck_state_;
+    ///guards resizing the puck arrays against puck states set by the refbox
+    boost::mutex puck_mutex_;
+
+    ///light signals of all machines as sent to the robots, rebuilt after changes
+    llsf_msgs::AllMachineSignals machine_signals_;
+    ///set by the refbox callback, cleared by the robots reading the signals
+    std::atomic<bool> machine_signals_changed_;
+
+    ///resolved puck links, empty if the link does not exist (yet)
+    std::vector<physics::EntityPtr> puck_entity_;
+    ///pucks whose missing link was already reported
+    std::vector<bool> puck_missing_reported_;
+
+    ///Suscribers to notice models being added or removed
+    transport::SubscriberPtr model_info_sub_;
+    transport::SubscriberPtr request_sub_;
+    ///model changes since the last refresh of the puck links
+    boost::mutex entity_mutex_;
+    bool entities_changed_;
+    ///models which are requested to be deleted and not added again yet
+    std::set<std::string> deleted_models_;
+
+    void on_model_info_msg(ConstModelPtr &msg);
+    void on_request_msg(ConstRequestPtr &msg);
 
     void init_table();
     void init_machine(MachineName number, std::string name_, std::string name_string);
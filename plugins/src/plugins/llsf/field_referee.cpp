@@ -21,6 +21,7 @@
 
 #include "field_referee.h"
 #include <stdio.h>
+#include <gazsim_msgs/ReleasePuck.pb.h>
 
 
 using namespace gazebo;
@@ -32,6 +33,11 @@ FieldReferee::FieldReferee(physics::WorldPtr world)
 {
   table_ = LlsfDataTable::get_table();
   world_ = world;
+
+  //the namespace is set to the world name!
+  node_ = transport::NodePtr(new transport::Node());
+  node_->Init(world_->GetName());
+  release_pub_ = node_->Advertise<gazsim_msgs::ReleasePuck>(TOPIC_PUCK_RELEASE);
   
   finished_pucks_ = 0;
   waiting_before_removing_ = false;
@@ -46,20 +52,40 @@ FieldReferee::~FieldReferee()
 void FieldReferee::update()
 {
   //check if the referee app says that there is a puck which has to be removed
-  for(int p = 0; p < NUMBER_PUCKS; p++)
+  unsigned int num_pucks = table_->num_pucks();
+  const llsf_msgs::PuckState *puck_states = table_->get_puck_states();
+  const double *puck_x = table_->get_puck_x();
+  const double *puck_y = table_->get_puck_y();
+  for(unsigned int p = 0; p < num_pucks; p++)
   {
-    
-    Puck puck = table_->get_puck(p);
-    if(puck.state == llsf_msgs::FINISHED && puck.x < 5.6 && puck.y < 5.6)
+    if(puck_states[p] == llsf_msgs::FINISHED && puck_x[p] < 5.6 && puck_y[p] < 5.6)
     {
       if(waiting_before_removing_)
       {
 	if(world_->GetSimTime().Double() > start_waiting_time_ + WAIT_TIME_BEFORE_REMOVE)
 	{
-	  //build a tower
-	  math::Pose pose(6.0, 2.8, (0.1 + finished_pucks_ * 0.05), 0, 0, 0);
-	  world_->GetEntity(puck.name_link.c_str())->SetWorldPose(pose, true, true);
-	  finished_pucks_++;
+	  //the link is named <model>::<link>, registered workpieces are found without a search
+	  const std::string &name_link = table_->get_puck_name_link(p);
+	  std::string model_name = name_link.substr(0, name_link.find("::"));
+	  physics::EntityPtr puck_entity = gazebo_rcll::WorkpieceRegistry::get_registry()->get(model_name);
+	  if(!puck_entity)
+	  {
+	    puck_entity = table_->get_puck_entity(p);
+	  }
+	  if(release_pub_->HasConnections())
+	  {
+	    //return the puck to the workpiece pool
+	    gazsim_msgs::ReleasePuck release_msg;
+	    release_msg.set_puck_name(model_name);
+	    release_pub_->Publish(release_msg);
+	  }
+	  else if(puck_entity)
+	  {
+	    //build a tower
+	    math::Pose pose(6.0, 2.8, (0.1 + finished_pucks_ * 0.05), 0, 0, 0);
+	    puck_entity->SetWorldPose(pose, true, true);
+	    finished_pucks_++;
+	  }
 	  waiting_before_removing_ = false;
 	}
       }
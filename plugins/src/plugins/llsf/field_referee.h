@@ -25,9 +25,13 @@
 #include <string>
 #include <gazebo/gazebo.hh>
 #include <gazebo/physics/physics.hh>
+#include <gazebo/transport/transport.hh>
 #include "data_table.h"
+#include <workpieces/workpiece_registry.h>
 
 #define WAIT_TIME_BEFORE_REMOVE 3.0
+//topic of the workpiece pool to return finished pucks to
+#define TOPIC_PUCK_RELEASE "~/pucks/release"
 
 namespace gazebo
 {
@@ -52,6 +56,10 @@ namespace gazebo
     
     physics::WorldPtr world_;
 
+    ///Node and publisher to return finished pucks to the workpiece pool
+    transport::NodePtr node_;
+    transport::PublisherPtr release_pub_;
+
     int finished_pucks_;
     
     bool waiting_before_removing_;
@@ -44,9 +44,16 @@ LightControl::LightControl(physics::WorldPtr world)
   node_ = transport::NodePtr(new transport::Node());
   world_ = world;
   node_->Init(world_->GetName().c_str());
-  visPub_ = this->node_->Advertise<msgs::Visual>("~/visual", NUMBER_MACHINES * 3);
   table_ = LlsfDataTable::get_table();
+  visPub_ = this->node_->Advertise<msgs::Visual>("~/visual", table_->num_machines() * 3);
   last_sent_time_ = world_->GetSimTime().Double();
+  last_refresh_time_ = last_sent_time_;
+  sent_state_.assign(table_->num_machines() * 3, -1);
+  stats_start_time_ = last_sent_time_;
+  stats_sent_ = 0;
+  stats_checks_ = 0;
+
+  light_stats_interval_ = config->get_float("plugins/llsf/light-stats-interval");
 }
 LightControl::~LightControl()
 {
@@ -66,8 +73,8 @@ void LightControl::update()
   {
     return;
   }  
-  //update lights twice a second
-  if(time - last_sent_time_ < 0.5)
+  //check lights twice a second
+  if(time - last_sent_time_ < LIGHT_UPDATE_INTERVAL)
   {
     return;
   }
@@ -76,45 +83,90 @@ void LightControl::update()
   if(!visPub_->HasConnections())
   {
     printf("light_control: visual publisher not connected!\n");
+    //whoever connects next needs all lights
+    sent_state_.assign(table_->num_machines() * 3, -1);
     return;
   }
 
-  //update all machines
+  if(visuals_.empty())
+  {
+    create_vis_msgs();
+  }
+  if(time - last_refresh_time_ >= LIGHT_REFRESH_INTERVAL)
+  {
+    last_refresh_time_ = time;
+    sent_state_.assign(table_->num_machines() * 3, -1);
+  }
+
+  //resolve BLINK (Machines Blink at 1Hz)
+  LightState blink_state = fmod(time, 1) >= 0.5 ? OFF : ON;
+
+  //collect the lights which changed since they were sent last
+  std::vector<const msgs::Visual *> changed;
+  Machine* machines = table_->get_machines();
+  for(unsigned int i = 0; i < table_->num_machines(); i++)
+  {
+    const Machine &machine = machines[i];
+    LightState states[3] = {machine.red, machine.yellow, machine.green};
+    for(int color = 0; color < 3; color++)
+    {
+      LightState state = states[color] == BLINK ? blink_state : states[color];
+      int light = i * 3 + color;
+      if(sent_state_[light] != state)
+      {
+        sent_state_[light] = state;
+        changed.push_back(&visuals_[light * 2 + (state == ON ? 1 : 0)]);
+      }
+    }
+  }
+
+  //send all changes in one batch
+  for(const msgs::Visual *msg : changed)
+  {
+    visPub_->Publish(*msg);
+  }
+
+  stats_sent_ += changed.size();
+  stats_checks_++;
+  if(LIGHT_STATS_INTERVAL > 0 && time - stats_start_time_ >= LIGHT_STATS_INTERVAL)
+  {
+    print_stats(time);
+  }
+}
+
+//prebuilds the off and on visual of every light
+void LightControl::create_vis_msgs()
+{
   Machine* machines = table_->get_machines();
-  for(int i = 0; i < NUMBER_MACHINES; i++)
+  visuals_.clear();
+  visuals_.reserve(table_->num_machines() * 3 * 2);
+  for(unsigned int i = 0; i < table_->num_machines(); i++)
   {
-    //the actual magic
-    Machine machine = machines[i];
-    // printf("Machine %s\n", machine.name_string.c_str());
-    // printf("Red: %d\n", machine.red);
-    // printf("Yellow: %d\n", machine.yellow);
-    // printf("Green: %d\n", machine.green);
-    visPub_->Publish(create_vis_msg(machine.name_link, RED, machine.red));
-    visPub_->Publish(create_vis_msg(machine.name_link, YELLOW, machine.yellow));
-    visPub_->Publish(create_vis_msg(machine.name_link, GREEN, machine.green));
+    for(int color = RED; color <= GREEN; color++)
+    {
+      visuals_.push_back(create_vis_msg(machines[i].name_link, (Color) color, OFF));
+      visuals_.push_back(create_vis_msg(machines[i].name_link, (Color) color, ON));
+    }
   }
 }
 
+//prints how many visual messages were sent compared to sending all lights on each check
+void LightControl::print_stats(double time)
+{
+  double duration = time - stats_start_time_;
+  printf("light_control: %.1f visual msgs/s sent (%.1f msgs/s when sending all lights)\n",
+         stats_sent_ / duration, stats_checks_ * table_->num_machines() * 3 / duration);
+  stats_start_time_ = time;
+  stats_sent_ = 0;
+  stats_checks_ = 0;
+}
+
 //creates all needed visual messages
 msgs::Visual LightControl::create_vis_msg(std::string machine_name, Color color, LightState state)
 {
   //create message to return
   msgs::Visual msg;
 
-  //resolve BLINK (Machines Blink at 2Hz)
-  if(state == BLINK)
-  {
-    double time = world_->GetSimTime().Double();  
-    if(fmod(time,1) >= 0.5)
-    {
-      state = OFF;
-    }
-    else
-    {
-      state = ON;
-    }
-  }
-  
   //common parameters
   msg.set_parent_name(machine_name.c_str());
   msgs::Geometry *geomMsg = msg.mutable_geometry();
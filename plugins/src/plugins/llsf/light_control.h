@@ -22,10 +22,19 @@
 #define _LIGHT_CONTROL_HH_
 
 #include <string>
+#include <vector>
 #include <gazebo/msgs/msgs.hh>
 #include <gazebo/physics/physics.hh>
+#include <configurable/configurable.h>
 #include "data_table.h"
 
+//interval in which the light states are checked, half the blink period (machines blink at 1Hz)
+#define LIGHT_UPDATE_INTERVAL 0.5
+//all lights are resent in this interval for clients connecting late
+#define LIGHT_REFRESH_INTERVAL 10.0
+//interval in which the number of sent visual messages is printed, 0 to disable
+#define LIGHT_STATS_INTERVAL light_stats_interval_
+
 namespace gazebo
 {  
   typedef enum Color
@@ -44,7 +53,7 @@ namespace gazebo
   /**
    * controls the Machine Lights in the visualization
    */
-  class LightControl
+  class LightControl : public gazebo_rcll::ConfigurableAspect
   {
   public: 
     //Constructor
@@ -62,9 +71,26 @@ namespace gazebo
     transport::PublisherPtr visPub_;
 
     msgs::Visual create_vis_msg(std::string machine_name, Color color, LightState state);
+    void create_vis_msgs();
+    void print_stats(double time);
 
     ///time variable to send in intervals
     double last_sent_time_;
+    ///time of the last complete resend of all lights
+    double last_refresh_time_;
+
+    ///prebuilt off and on visual of each light, index (machine * 3 + color) * 2 + on
+    std::vector<msgs::Visual> visuals_;
+    ///last sent state of each light (OFF or ON), -1 if unknown
+    std::vector<int> sent_state_;
+
+    ///statistics of sent visual messages
+    double stats_start_time_;
+    unsigned int stats_sent_;
+    unsigned int stats_checks_;
+
+    //config values:
+    double light_stats_interval_;
 
     physics::WorldPtr world_;
 
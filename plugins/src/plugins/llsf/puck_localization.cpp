@@ -40,20 +40,20 @@ PuckLocalization::~PuckLocalization()
 
 void PuckLocalization::update()
 {
-  for(int p = 0; p < NUMBER_PUCKS; p++)
-  {
-    Puck puck = table_->get_puck(p);
+  table_->refresh_puck_entities();
 
-    //get position from world position of the Puck model
-    if(!world_->GetEntity(puck.name_link.c_str()))
+  unsigned int num_pucks = table_->num_pucks();
+  for(unsigned int p = 0; p < num_pucks; p++)
+  {
+    //get position from world position of the Puck model, missing pucks keep their last position
+    physics::EntityPtr puck = table_->get_puck_entity(p);
+    if(!puck)
     {
-      printf("Can not find puck with index %d\n", p);
-      return;
+      continue;
     }
-    double x = world_->GetEntity(puck.name_link.c_str())->GetWorldPose().pos.x;
-    double y = world_->GetEntity(puck.name_link.c_str())->GetWorldPose().pos.y;
+    math::Vector3 pos = puck->GetWorldPose().pos;
 
     //write it into the data table
-    table_->set_puck_pos(p, x, y);
+    table_->set_puck_pos(p, pos.x, pos.y);
   }
 }
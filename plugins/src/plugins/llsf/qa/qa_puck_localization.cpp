@@ -0,0 +1,107 @@
+/***************************************************************************
+ *  qa_puck_localization.cpp - puck localization tick time benchmark
+ *
+ *  Created: Sat Oct 17 11:53:20 2026
+ *  Copyright  2026  agent
+ *
+ ****************************************************************************/
+
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.GPL file in the doc directory.
+ */
+
+// Do not mention in API doc
+/// @cond QA
+
+// Inserts pucks into an empty world, adds them to the data table and
+// measures the wall-clock time of PuckLocalization::update().
+
+#include "../data_table.h"
+#include "../puck_localization.h"
+
+#include <gazebo/gazebo.hh>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+
+using namespace gazebo;
+
+static const unsigned int STEPS[] = { 20, 50, 100 };
+static const unsigned int NUM_STEPS = sizeof(STEPS) / sizeof(STEPS[0]);
+
+static std::string
+puck_sdf(unsigned int i)
+{
+  std::ostringstream ss;
+  ss << "<sdf version='1.4'><model name='Puck" << i << "'>"
+     << "<pose>" << (i % 10) * 0.2 << " " << (i / 10) * 0.2 << " 0.025 0 0 0</pose>"
+     << "<link name='cylinder'><collision name='collision'><geometry>"
+     << "<cylinder><radius>0.02</radius><length>0.05</length></cylinder>"
+     << "</geometry></collision></link></model></sdf>";
+  return ss.str();
+}
+
+int
+main(int argc, char **argv)
+{
+  unsigned int updates = argc > 1 ? atoi(argv[1]) : 10000;
+
+  if(!gazebo::setupServer(argc, argv))
+  {
+    printf("Failed to set up gazebo server\n");
+    return 1;
+  }
+  physics::WorldPtr world = gazebo::loadWorld("worlds/empty.world");
+  if(!world)
+  {
+    printf("Failed to load empty world\n");
+    gazebo::shutdown();
+    return 1;
+  }
+
+  transport::NodePtr node(new transport::Node());
+  node->Init(world->GetName());
+  LlsfDataTable::init(world, node);
+  LlsfDataTable *table = LlsfDataTable::get_table();
+  PuckLocalization localization(world);
+
+  unsigned int inserted = 0;
+  for(unsigned int s = 0; s < NUM_STEPS; s++)
+  {
+    for(; inserted < STEPS[s]; inserted++)
+    {
+      world->InsertModelString(puck_sdf(inserted));
+      std::ostringstream name_link;
+      name_link << "Puck" << inserted << "::cylinder";
+      table->add_puck(name_link.str());
+    }
+    //let the models load and the table notice them
+    gazebo::runWorld(world, 100);
+    localization.update();
+
+    common::Time start = common::Time::GetWallTime();
+    for(unsigned int i = 0; i < updates; i++)
+    {
+      localization.update();
+    }
+    double time = (common::Time::GetWallTime() - start).Double();
+    printf("%3u pucks: %8.3f us per update (%u updates)\n",
+           inserted, time / updates * 1e6, updates);
+  }
+
+  LlsfDataTable::finalize();
+  node->Fini();
+  gazebo::shutdown();
+  return 0;
+}
+
+/// @endcond
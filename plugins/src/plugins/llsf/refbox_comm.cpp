@@ -128,9 +128,7 @@ void RefboxComm::on_puck_info_msg(ConstPuckInfoPtr &msg)
   {
     llsf_msgs::Puck puck = msg->pucks(i);
     int id = puck.id() - 1;//-1 because the refbox starts with 1
-    if(id < NUMBER_PUCKS)
-    {
-      table_->set_puck_state(id, puck.state());
-    }
+    //unknown pucks are ignored by the table
+    table_->set_puck_state(id, puck.state());
   }
 }
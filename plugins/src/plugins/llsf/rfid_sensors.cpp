@@ -25,8 +25,19 @@
 using namespace gazebo;
 
 RfidSensors::RfidSensors()
+  : rfid_grid_(RFID_GRID_CELL_SIZE)
 {
   table_ = LlsfDataTable::get_table();
+
+  //the machines do not move, so the rfid-sensor centers are computed once
+  Machine* machines = table_->get_machines();
+  for(unsigned int m = 0; m < table_->num_machines(); m++)
+  {
+    const Machine &machine = machines[m];
+    double rfid_x = machine.x + DIST_CENTER_RFID * cos(machine.ori);
+    double rfid_y = machine.y + DIST_CENTER_RFID * sin(machine.ori);
+    rfid_grid_.add_zone(rfid_x, rfid_y, 0.0, UNDER_RFID_TOL);
+  }
 }
 
 RfidSensors::~RfidSensors()
@@ -36,35 +47,31 @@ RfidSensors::~RfidSensors()
 
 void RfidSensors::update()
 { 
-  //for all machines check if there is any puck anderneath it
+  //for all pucks look up the rfid-sensor they are under
   Machine* machines = table_->get_machines();
-  for(int m = 0; m < NUMBER_MACHINES; m++)
+  unsigned int num_pucks = table_->num_pucks();
+  const double *puck_x = table_->get_puck_x();
+  const double *puck_y = table_->get_puck_y();
+  const MachineName *under_rfid = table_->get_pucks_under_rfid();
+  for(unsigned int p = 0; p < num_pucks; p++)
   {
-    Machine machine = machines[m];
-    //calculate center of rfid-sensor
-    double rfid_x = machine.x + DIST_CENTER_RFID * cos(machine.ori);
-    double rfid_y = machine.y + DIST_CENTER_RFID * sin(machine.ori);
-    
-    //check all pucks
-    for(int p = 0; p < NUMBER_PUCKS; p++)
+    rfid_grid_.find(puck_x[p], puck_y[p], 0.0, hits_);
+    MachineName under = hits_.empty() ? NONE : machines[hits_.front()].name;
+
+    //only placing and removing is reported
+    if(under == under_rfid[p])
+    {
+      continue;
+    }
+    if(under_rfid[p] != NONE)
+    {
+      //printf("Puck %d is no longer under %s\n", p, machines[under_rfid[p]].name_link.c_str());
+      table_->remove_puck_under_rfid(p, under_rfid[p]);
+    }
+    if(under != NONE)
     {
-      Puck puck = table_->get_puck(p);
-      double dist = sqrt((puck.x - rfid_x) * (puck.x - rfid_x)
-			 + (puck.y - rfid_y) * (puck.y - rfid_y));
-      if(dist < UNDER_RFID_TOL)
-      {
-	//printf("Puck %d is under %s\n", p, machine.name_link.c_str());
-	if(puck.under_rfid != NONE && puck.under_rfid != machine.name)
-	{
-	  table_->remove_puck_under_rfid(p, puck.under_rfid);
-	}
-	table_->set_puck_under_rfid(p, machine.name);
-      }
-      else if (puck.under_rfid == machine.name)
-      {
-	//printf("Puck %d is no longer under %s\n", p, machine.name_link.c_str());
-	table_->remove_puck_under_rfid(p, machine.name);
-      }
+      //printf("Puck %d is under %s\n", p, machines[under].name_link.c_str());
+      table_->set_puck_under_rfid(p, under);
     }
   }
 }
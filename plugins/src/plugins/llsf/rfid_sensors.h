@@ -25,17 +25,22 @@
 #define UNDER_RFID_TOL 0.05
 //distance of the rfid-sensor-center from machine-center in x-dim
 #define DIST_CENTER_RFID 0.06
+//edge length of the grid cells used to look up the rfid-sensor of a puck position
+#define RFID_GRID_CELL_SIZE 0.1
 
 
 #include <string>
 #include <gazebo/gazebo.hh>
 #include <gazebo/physics/physics.hh>
+#include <utils/geometry/zone_grid.h>
+#include <vector>
 #include "data_table.h"
 
 namespace gazebo
 {
   /**
    * checks if a puck is under a rfid sensor
+   * and reports only when a puck is placed under or removed from it
    *
    * (only works if you do not move the field)
    */
@@ -56,6 +61,11 @@ namespace gazebo
 
     ///Pointer to simulation data
     LlsfDataTable *table_;
+
+    ///areas of the rfid-sensors, the zone id is the machine index
+    fawkes::ZoneGrid rfid_grid_;
+    ///zones containing the puck, reused in each update
+    std::vector<unsigned int> hits_;
   };
 }
 #endif
@@ -89,7 +89,11 @@ void BaseStation::new_machine_info(ConstMachine &machine)
 void BaseStation::on_new_puck(ConstNewPuckPtr &msg)
 {
   Mps::on_new_puck(msg);
-  physics::ModelPtr new_puck = world_->GetModel(msg->puck_name());
+  physics::ModelPtr new_puck = registry_->get(msg->puck_name());
+  if(!new_puck)
+  {
+    return;
+  }
   if(puck_in_input(new_puck->GetWorldPose()) || puck_in_output(new_puck->GetWorldPose()))
   {
     have_puck_ = new_puck->GetName();
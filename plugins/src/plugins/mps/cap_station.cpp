@@ -27,10 +27,15 @@ using namespace gazebo;
 CapStation::CapStation(physics::ModelPtr _parent, sdf::ElementPtr _sdf) :
   Mps(_parent,_sdf)
 {
+  compute_shelf_geometry();
+  shelf_left_region_ = tracker_->add_region(this, shelf_left_pose(), 0.1);
+  shelf_middle_region_ = tracker_->add_region(this, shelf_middle_pose(), 0.1);
+  shelf_right_region_ = tracker_->add_region(this, shelf_right_pose(), 0.1);
   spawn_puck(shelf_left_pose(), gazsim_msgs::Color::RED);
   spawn_puck(shelf_middle_pose(), gazsim_msgs::Color::RED);
   spawn_puck(shelf_right_pose(), gazsim_msgs::Color::RED);
-  workpiece_result_subscriber_ = node_->Subscribe(TOPIC_PUCK_COMMAND_RESULT ,&CapStation::on_puck_result,this);
+  //results of commands sent by this station are addressed to it
+  workpiece_result_subscriber_ = node_->Subscribe(TOPIC_PUCK_COMMAND_RESULT + "/" + name_, &CapStation::on_puck_result,this);
   stored_cap_color_ = gazsim_msgs::Color::NONE;
   puck_spawned_time_ = created_time_;
 }
@@ -43,18 +48,7 @@ void CapStation::OnUpdate(const common::UpdateInfo &info)
     return;
   }
 
-  if(puck_in_shelf_left_ && !pose_hit(puck_in_shelf_left_->GetWorldPose(),shelf_left_pose(),0.1))
-  {
-    puck_in_shelf_left_ = NULL;
-  }
-  if(puck_in_shelf_middle_ && !pose_hit(puck_in_shelf_middle_->GetWorldPose(),shelf_middle_pose(),0.1))
-  {
-    puck_in_shelf_middle_ = NULL;
-  }
-  if(puck_in_shelf_right_ && !pose_hit(puck_in_shelf_right_->GetWorldPose(),shelf_right_pose(),0.1))
-  {
-    puck_in_shelf_right_ = NULL;
-  }
+  //the shelf slots are cleared in workpiece_left
   if(!puck_in_shelf_right_ && !puck_in_shelf_middle_ && !puck_in_shelf_left_){
     //shelf is empty -> refill
     spawn_puck(shelf_left_pose(), gazsim_msgs::Color::RED);
@@ -64,11 +58,45 @@ void CapStation::OnUpdate(const common::UpdateInfo &info)
   }
 }
 
+void CapStation::workpiece_left(unsigned int region, const std::string &puck_name,
+                                const math::Pose &pose)
+{
+  if(region == shelf_left_region_)
+  {
+    if(puck_in_shelf_left_ && puck_in_shelf_left_->GetName() == puck_name)
+      puck_in_shelf_left_ = NULL;
+  }
+  else if(region == shelf_middle_region_)
+  {
+    if(puck_in_shelf_middle_ && puck_in_shelf_middle_->GetName() == puck_name)
+      puck_in_shelf_middle_ = NULL;
+  }
+  else if(region == shelf_right_region_)
+  {
+    if(puck_in_shelf_right_ && puck_in_shelf_right_->GetName() == puck_name)
+      puck_in_shelf_right_ = NULL;
+  }
+  else
+  {
+    Mps::workpiece_left(region, puck_name, pose);
+  }
+}
+
+void CapStation::update_geometry()
+{
+  Mps::update_geometry();
+  compute_shelf_geometry();
+  tracker_->move_region(shelf_left_region_, shelf_left_pose());
+  tracker_->move_region(shelf_middle_region_, shelf_middle_pose());
+  tracker_->move_region(shelf_right_region_, shelf_right_pose());
+}
+
 void CapStation::work_puck(std::string puck_name)
 {
   set_state(State::AVAILABLE);
   gazsim_msgs::WorkpieceCommand cmd_msg = gazsim_msgs::WorkpieceCommand();
   cmd_msg.set_puck_name(puck_name);
+  cmd_msg.set_requester(name_);
   switch(task_)
   {
     case llsf_msgs::CsOp::RETRIEVE_CAP:
@@ -98,7 +126,7 @@ void CapStation::work_puck(std::string puck_name)
       break;
   }
   //set_state(State::PROCESSED);
-  world_->GetModel(puck_name)->SetWorldPose(output());
+  registry_->get(puck_name)->SetWorldPose(output());
   puck_in_processing_name_ = puck_name;
 }
 
@@ -107,7 +135,7 @@ void CapStation::on_puck_msg(ConstPosePtr &msg)
   if(current_state_ == "READY-AT-OUTPUT")
   {
     if(puck_in_processing_name_ != "" && 
-       !puck_in_output(world_->GetModel(puck_in_processing_name_)->GetWorldPose()))
+       !puck_in_output(registry_->get(puck_in_processing_name_)->GetWorldPose()))
     {
       set_state(State::RETRIEVED);
       puck_in_processing_name_ = "";
@@ -126,38 +154,34 @@ void CapStation::on_puck_msg(ConstPosePtr &msg)
 void CapStation::on_new_puck(ConstNewPuckPtr &msg)
 {
   Mps::on_new_puck(msg);
-  //get model
-  physics::Model_V models = world_->GetModels();
-  for(physics::ModelPtr model: models)
+  physics::ModelPtr model = registry_->get(msg->puck_name());
+  if(model)
   {
-    if(model->GetName() == msg->puck_name())
+    gazsim_msgs::WorkpieceCommand cmd;
+    cmd.set_command(gazsim_msgs::Command::ADD_CAP);
+    if(name_.find("CS1") != std::string::npos)
     {
-      gazsim_msgs::WorkpieceCommand cmd;
-      cmd.set_command(gazsim_msgs::Command::ADD_CAP);
-      if(name_.find("CS1") != std::string::npos)
-      {
-        cmd.set_color(gazsim_msgs::Color::GREY);
-      }
-      else if(name_.find("CS2") != std::string::npos)
-      {
-        cmd.set_color(gazsim_msgs::Color::BLACK);
-      }
-      cmd.set_puck_name(msg->puck_name());
-      if(pose_in_shelf_left(model->GetWorldPose()))
-      {
-        puck_in_shelf_left_ = model;
-        puck_cmd_pub_->Publish(cmd);
-      }
-      else if(pose_in_shelf_middle(model->GetWorldPose()))
-      {
-        puck_in_shelf_middle_ = model;
-        puck_cmd_pub_->Publish(cmd);
-      }
-      else if(pose_in_shelf_right(model->GetWorldPose()))
-      {
-        puck_in_shelf_right_ = model;
-        puck_cmd_pub_->Publish(cmd);
-      }
+      cmd.set_color(gazsim_msgs::Color::GREY);
+    }
+    else if(name_.find("CS2") != std::string::npos)
+    {
+      cmd.set_color(gazsim_msgs::Color::BLACK);
+    }
+    cmd.set_puck_name(msg->puck_name());
+    if(pose_in_shelf_left(model->GetWorldPose()))
+    {
+      puck_in_shelf_left_ = model;
+      puck_cmd_pub_->Publish(cmd);
+    }
+    else if(pose_in_shelf_middle(model->GetWorldPose()))
+    {
+      puck_in_shelf_middle_ = model;
+      puck_cmd_pub_->Publish(cmd);
+    }
+    else if(pose_in_shelf_right(model->GetWorldPose()))
+    {
+      puck_in_shelf_right_ = model;
+      puck_cmd_pub_->Publish(cmd);
     }
   }
 }
@@ -169,14 +193,14 @@ void CapStation::new_machine_info(ConstMachine &machine)
     task_ = machine.instruction_cs().operation();
     printf("%s got a new task: %s\n",name_.c_str(),llsf_msgs::CsOp_Name(task_).c_str());
   }
-  else if(machine.state() == "PROCESSED" && puck_in_output(world_->GetModel(puck_in_processing_name_)->GetWorldPose()))
+  else if(machine.state() == "PROCESSED" && puck_in_output(registry_->get(puck_in_processing_name_)->GetWorldPose()))
   {
     set_state(State::DELIVERED);
   }
   else if(machine.state() == "IDLE" &&
           current_state_ == "DOWN")
   {
-    for(gazebo::physics::ModelPtr model: world_->GetModels())
+    for(gazebo::physics::ModelPtr model: registry_->models())
     {
       if(pose_hit(model->GetWorldPose(),input()))
       {
@@ -203,19 +227,26 @@ void CapStation::on_puck_result(ConstWorkpieceResultPtr &result)
   }
 }
 
+void CapStation::compute_shelf_geometry()
+{
+  shelf_left_pose_ = get_puck_world_pose(-0.1, 0, BELT_HEIGHT + 0.005);
+  shelf_middle_pose_ = get_puck_world_pose(-0.2, 0, BELT_HEIGHT + 0.005);
+  shelf_right_pose_ = get_puck_world_pose(-0.3,0, BELT_HEIGHT + 0.005);
+}
+
 math::Pose CapStation::shelf_left_pose()
 {
-  return get_puck_world_pose(-0.1, 0, BELT_HEIGHT + 0.005);
+  return shelf_left_pose_;
 }
 
 math::Pose CapStation::shelf_middle_pose()
 {
-  return get_puck_world_pose(-0.2, 0, BELT_HEIGHT + 0.005);
+  return shelf_middle_pose_;
 }
 
 math::Pose CapStation::shelf_right_pose()
 {
-  return get_puck_world_pose(-0.3,0, BELT_HEIGHT + 0.005);
+  return shelf_right_pose_;
 }
 
 
@@ -41,6 +41,8 @@ public:
   void OnUpdate(const common::UpdateInfo &info);
   void new_machine_info(ConstMachine &machine);
   void on_puck_result(ConstWorkpieceResultPtr &result);
+  void workpiece_left(unsigned int region, const std::string &puck_name,
+                      const math::Pose &pose);
   
   math::Pose shelf_left_pose();
   math::Pose shelf_middle_pose();
@@ -53,6 +55,15 @@ public:
   physics::ModelPtr puck_in_shelf_left_;
   physics::ModelPtr puck_in_shelf_middle_;
   physics::ModelPtr puck_in_shelf_right_;
+
+  unsigned int shelf_left_region_;
+  unsigned int shelf_middle_region_;
+  unsigned int shelf_right_region_;
+  void update_geometry();
+  void compute_shelf_geometry();
+  math::Pose shelf_left_pose_;
+  math::Pose shelf_middle_pose_;
+  math::Pose shelf_right_pose_;
   
   llsf_msgs::CsOp task_;
   gazsim_msgs::Color stored_cap_color_;
@@ -25,7 +25,8 @@
 using namespace gazebo;
 
 DeliveryStation::DeliveryStation(physics::ModelPtr _parent, sdf::ElementPtr  _sdf) :
-  Mps(_parent,_sdf)
+  Mps(_parent,_sdf),
+  pool_release_delay_(config, "plugins/mps/delivery-station/pool_release_delay")
 {
   selected_gate_ = 0;
 }
@@ -35,7 +36,7 @@ void DeliveryStation::on_puck_msg(ConstPosePtr &msg)
   if(puck_in_input(msg) &&
      !is_puck_hold(msg->name()))
   {
-    physics::ModelPtr puck = world_->GetModel(msg->name());
+    physics::ModelPtr puck = registry_->get(msg->name());
     printf("%s got puck %s for gate %i\n",this->name_.c_str(), puck->GetName().c_str(), selected_gate_);
     bool successfull_deliver = true;
     switch(selected_gate_)
@@ -70,6 +71,8 @@ void DeliveryStation::on_puck_msg(ConstPosePtr &msg)
         cmd_msg.set_team_color(gazsim_msgs::Team::MAGENTA);
       }
       puck_cmd_pub_->Publish(cmd_msg);
+      //show the delivered workpiece for a while, then return it to the pool
+      pool_->release_puck(msg->name(), POOL_RELEASE_DELAY);
     }
   }
 }
@@ -25,6 +25,9 @@
 
 #include "mps.h"
 
+//how long a delivered workpiece stays at the gate before it is returned to the pool
+#define POOL_RELEASE_DELAY pool_release_delay_.get()
+
 namespace gazebo
 {
 
@@ -37,6 +40,10 @@ public:
   void new_machine_info(ConstMachine &machine);
   
   uint selected_gate_;
+
+private:
+  //config values:
+  gazebo_rcll::ConfigValueHandle<float> pool_release_delay_;
 };
 
 }
@@ -51,6 +51,7 @@ Mps::Mps(physics::ModelPtr _parent, sdf::ElementPtr)
 
   //get the model-name
   this->name_ = model_->GetName();
+  replay_pending_ = false;
   printf("Loading Mps Plugin of model %s\n", name_.c_str());
 
   number_pucks_ = config->get_int("plugins/mps/number_pucks");
@@ -82,8 +83,8 @@ Mps::Mps(physics::ModelPtr _parent, sdf::ElementPtr)
   created_time_ = model_->GetWorld()->GetSimTime().Double();
   spawned_tags_last_ = model_->GetWorld()->GetSimTime().Double();
 
-  //subscribe to machine info
-  this->machine_info_subscriber_ = this->node_->Subscribe(TOPIC_MACHINE_INFO, &Mps::on_machine_msg, this);
+  //subscribe to the machine info of this machine
+  this->machine_info_subscriber_ = this->node_->Subscribe(TOPIC_MACHINE_INFO + name_, &Mps::on_machine_msg, this);
   
   this->new_puck_subscriber_ = node_->Subscribe("~/new_puck",&Mps::on_new_puck,this);
 
@@ -92,8 +93,19 @@ Mps::Mps(physics::ModelPtr _parent, sdf::ElementPtr)
   set_machne_state_pub_ = this->node_->Advertise<llsf_msgs::SetMachineState>(TOPIC_SET_MACHINE_STATE);
   
   world_ = model_->GetWorld();
+
+  //puck positions are reported by the world wide tracker
+  WorkpieceTracker::init(world_);
+  tracker_ = WorkpieceTracker::get_tracker();
+  //workpieces are spawned from a pool of reused models
+  WorkpiecePool::init(world_);
+  pool_ = WorkpiecePool::get_pool();
+  registry_ = gazebo_rcll::WorkpieceRegistry::get_registry();
+  mps_pose_ = model_->GetWorldPose();
+  compute_belt_geometry();
+  input_region_ = tracker_->add_region(this, input(), DETECT_TOLERANCE);
+  output_region_ = tracker_->add_region(this, output(), DETECT_TOLERANCE);
   
-  factoryPub = node_->Advertise<msgs::Factory>("~/factory");
   puck_cmd_pub_ = node_->Advertise<gazsim_msgs::WorkpieceCommand>(TOPIC_PUCK_COMMAND);
   joint_message_sub_ = node_->Subscribe(TOPIC_JOINT, &Mps::on_joint_msg, this);
 
@@ -109,12 +121,26 @@ Mps::Mps(physics::ModelPtr _parent, sdf::ElementPtr)
 Mps::~Mps()
 {
   printf("Destructing Mps Plugin for %s!\n",this->name_.c_str());
+  tracker_->remove_regions(this);
 }
 
 /** Called by the world update start event
  */
 void Mps::OnUpdate(const common::UpdateInfo & /*_info*/)
 {
+  math::Pose mps_pose = model_->GetWorldPose();
+  if(mps_pose != mps_pose_)
+  {
+    //e.g. moved by the mps placement
+    mps_pose_ = mps_pose;
+    update_geometry();
+  }
+  //replay requested by state or joint changes, run it in the physics thread like
+  //the tracker callbacks so the station logic never runs on two threads at once
+  if(replay_pending_.exchange(false))
+  {
+    replay_pucks_in_regions();
+  }
   if(!grabbed_tags_)
   {
 	  std::string input_tag_name = name_id_match.at(name_ + "I");
@@ -149,6 +175,83 @@ void Mps::on_puck_msg(ConstPosePtr &msg)
 
 }
 
+/** A puck entered one of the regions of this mps
+ * @param region id of the region
+ * @param puck_name name of the puck
+ * @param pose world pose of the puck
+ */
+void Mps::workpiece_entered(unsigned int region, const std::string &puck_name,
+                            const math::Pose &pose)
+{
+  deliver_puck_pose(puck_name, pose);
+}
+
+/** A puck left one of the regions of this mps
+ * @param region id of the region
+ * @param puck_name name of the puck
+ * @param pose world pose of the puck
+ */
+void Mps::workpiece_left(unsigned int region, const std::string &puck_name,
+                         const math::Pose &pose)
+{
+  deliver_puck_pose(puck_name, pose);
+}
+
+void Mps::deliver_puck_pose(const std::string &puck_name, const math::Pose &pose)
+{
+  msgs::Pose *pose_msg = new msgs::Pose();
+#if GAZEBO_MAJOR_VERSION > 5
+  msgs::Set(pose_msg, pose.Ign());
+#else
+  msgs::Set(pose_msg, pose);
+#endif
+  pose_msg->set_name(puck_name);
+  ConstPosePtr msg(pose_msg);
+  on_puck_msg(msg);
+}
+
+/** Pucks lying still in a region are not reported again,
+ * so the station logic is rerun for them when the mps state
+ * or the holding state of a puck changes.
+ * Has to be called from the world update thread.
+ */
+void Mps::replay_pucks_in_regions()
+{
+  std::map<std::string, math::Pose> pucks = tracker_->workpieces_in_regions(this);
+  for(const auto &puck : pucks)
+  {
+    deliver_puck_pose(puck.first, puck.second);
+  }
+}
+
+void Mps::update_geometry()
+{
+  compute_belt_geometry();
+  tracker_->move_region(input_region_, input_pose_);
+  tracker_->move_region(output_region_, output_pose_);
+}
+
+void Mps::compute_belt_geometry()
+{
+  double mps_ori = mps_pose_.rot.GetYaw();
+  mps_cos_ = cos(mps_ori);
+  mps_sin_ = sin(mps_ori);
+  input_pose_ = math::Pose(mps_pose_.pos.x
+                           + BELT_OFFSET_SIDE * mps_cos_
+                           - (BELT_LENGTH / 2 - PUCK_SIZE) * mps_sin_,
+                           mps_pose_.pos.y
+                           + BELT_OFFSET_SIDE * mps_sin_
+                           + (BELT_LENGTH / 2 - PUCK_SIZE) * mps_cos_,
+                           BELT_HEIGHT, 0, 0, 0);
+  output_pose_ = math::Pose(mps_pose_.pos.x
+                            + BELT_OFFSET_SIDE * mps_cos_
+                            + (BELT_LENGTH / 2 - PUCK_SIZE) * mps_sin_,
+                            mps_pose_.pos.y
+                            + BELT_OFFSET_SIDE * mps_sin_
+                            - (BELT_LENGTH / 2 - PUCK_SIZE) * mps_cos_,
+                            BELT_HEIGHT, 0, 0, 0);
+}
+
 void Mps::on_machine_msg(ConstMachineInfoPtr &msg)
 {
   for(const llsf_msgs::Machine &machine: msg->machines())
@@ -158,6 +261,7 @@ void Mps::on_machine_msg(ConstMachineInfoPtr &msg)
       printf("new_info for %s, state: %s \n",machine.name().c_str(), machine.state().c_str());
       new_machine_info(machine);
       current_state_ = machine.state();
+      replay_pending_ = true;
     }
   }
 }
@@ -219,51 +323,35 @@ void Mps::grabTag(std::string link_name, std::string tag_name, gazebo::physics::
   // printf("MPS %s: attached tag %s\n", name_.c_str(), tag_name.c_str());
 }
 
-  //compute locations of input and output (not sure about the sides jet)
+//locations of input and output, cached in update_geometry()
 float Mps::output_x()
 {
-  double mps_x = this->model_->GetWorldPose().pos.x;
-  double mps_ori = this->model_->GetWorldPose().rot.GetAsEuler().z;
-  return mps_x
-      + BELT_OFFSET_SIDE  * cos(mps_ori)
-      + (BELT_LENGTH / 2 - PUCK_SIZE) * sin(mps_ori);
+  return output_pose_.pos.x;
 }
 
 float Mps::output_y()
 {
-  double mps_y = this->model_->GetWorldPose().pos.y;
-  double mps_ori = this->model_->GetWorldPose().rot.GetAsEuler().z;
-  return mps_y
-      + BELT_OFFSET_SIDE  * sin(mps_ori)
-      - (BELT_LENGTH / 2 - PUCK_SIZE) * cos(mps_ori);
+  return output_pose_.pos.y;
 }
 
 float Mps::input_x()
 {
-  double mps_x = this->model_->GetWorldPose().pos.x;
-  double mps_ori = this->model_->GetWorldPose().rot.GetAsEuler().z;
-  return mps_x
-      + BELT_OFFSET_SIDE  * cos(mps_ori)
-      - (BELT_LENGTH / 2 - PUCK_SIZE) * sin(mps_ori);
+  return input_pose_.pos.x;
 }
 
 float Mps::input_y()
 {
-  double mps_y = this->model_->GetWorldPose().pos.y;
-  double mps_ori = this->model_->GetWorldPose().rot.GetAsEuler().z;
-  return mps_y
-    + BELT_OFFSET_SIDE  * sin(mps_ori)
-    + (BELT_LENGTH / 2 - PUCK_SIZE) * cos(mps_ori);
+  return input_pose_.pos.y;
 }
 
 math::Pose Mps::input()
 {
-  return math::Pose(input_x(), input_y(), BELT_HEIGHT,0,0,0);
+  return input_pose_;
 }
 
 math::Pose Mps::output()
 {
-  return math::Pose(output_x(), output_y(), BELT_HEIGHT,0,0,0);
+  return output_pose_;
 }
 
 bool Mps::pose_hit(const math::Pose &to_test, const math::Pose &reference, double tolerance)
@@ -278,131 +366,58 @@ bool Mps::pose_hit(const math::Pose &to_test, const math::Pose &reference, doubl
 
 bool Mps::puck_in_input(ConstPosePtr &pose)
 {
-  double dist = sqrt((pose->position().x() - input_x()) * (pose->position().x() - input_x())
-		     + (pose->position().y() - input_y()) * (pose->position().y() - input_y())
-		     + (pose->position().z() - BELT_HEIGHT) * (pose->position().z() - BELT_HEIGHT));
-  return dist < DETECT_TOLERANCE;
+  double dx = pose->position().x() - input_pose_.pos.x;
+  double dy = pose->position().y() - input_pose_.pos.y;
+  double dz = pose->position().z() - input_pose_.pos.z;
+  return dx * dx + dy * dy + dz * dz < DETECT_TOLERANCE * DETECT_TOLERANCE;
 }
 
 bool Mps::puck_in_output(ConstPosePtr &pose)
 {
-  double dist = sqrt((pose->position().x() - output_x()) * (pose->position().x() - output_x())
-		     + (pose->position().y() - output_y()) * (pose->position().y() - output_y())
-		     + (pose->position().z() - BELT_HEIGHT) * (pose->position().z() - BELT_HEIGHT));
-  return dist < DETECT_TOLERANCE;
+  double dx = pose->position().x() - output_pose_.pos.x;
+  double dy = pose->position().y() - output_pose_.pos.y;
+  double dz = pose->position().z() - output_pose_.pos.z;
+  return dx * dx + dy * dy + dz * dz < DETECT_TOLERANCE * DETECT_TOLERANCE;
 }
 
 bool Mps::puck_in_input(const math::Pose &pose)
 {
-  double dist = sqrt((pose.pos.x - input_x()) * (pose.pos.x - input_x())
-		     + (pose.pos.y - input_y()) * (pose.pos.y - input_y())
-		     + (pose.pos.z - BELT_HEIGHT) * (pose.pos.z - BELT_HEIGHT));
-  return dist < DETECT_TOLERANCE;
+  return pose_hit(pose, input_pose_);
 }
 
 bool Mps::puck_in_output(const math::Pose &pose)
 {
-  double dist = sqrt((pose.pos.x - output_x()) * (pose.pos.x - output_x())
-		     + (pose.pos.y - output_y()) * (pose.pos.y - output_y())
-		     + (pose.pos.z - BELT_HEIGHT) * (pose.pos.z - BELT_HEIGHT));
-  return dist < DETECT_TOLERANCE;
+  return pose_hit(pose, output_pose_);
 }
 
 void Mps::on_new_puck(ConstNewPuckPtr &msg)
 {
-    this->puck_subs_.push_back(this->node_->Subscribe(msg->gps_topic() , &Mps::on_puck_msg, this));
+  //the position of the new puck is tracked by the WorkpieceTracker
 }
 
 void Mps::spawn_puck(const math::Pose &spawn_pose, gazsim_msgs::Color base_color)
 {
   printf("spawning puck for %s\n",name_.c_str());
-  msgs::Factory new_puck_msg;
-
-  //use the workpiece_base sdf and replace the model name
-  //get the new puck name
-  std::string new_name = "puck_" + std::to_string(rand() % 1000000);
-  //Get sdf content
-  std::string sdf_path = getenv("GAZEBO_RCLL");
-  sdf_path += "/models/workpiece_base/model.sdf";
-  std::ifstream raw_sdf_file(sdf_path.c_str());
-  //exchange name
-  std::string new_sdf;
-  if (raw_sdf_file.is_open()){
-    std::string raw_sdf((std::istreambuf_iterator<char>(raw_sdf_file)),
-                        std::istreambuf_iterator<char>());
-    std::string old_name = "workpiece_base";
-    std::size_t name_pos = raw_sdf.find(old_name);
-    if(name_pos ==  std::string::npos){
-      return;
-    }
-    new_sdf = raw_sdf.erase(name_pos, old_name.length()).insert(name_pos, new_name);
-    std::string old_color = "1.0 0.35 0.0 1";
-    std::string new_color;
-    std::string color_string;
-    switch (base_color) {
-      case gazsim_msgs::Color::RED:
-        new_color = "1.0 0.0 0.0 1";
-        color_string = "RED";
-        break;
-      case gazsim_msgs::Color::BLACK:
-        new_color = "0.2 0.2 0.2 1";
-        color_string = "BLACK";
-        break;
-      case gazsim_msgs::Color::SILVER:
-        new_color = "0.8 0.8 0.8 1";
-        color_string = "SILVER";
-        break;
-      default:
-        printf("%s should spawn with an unsupported base color %s\n",new_name.c_str(), gazsim_msgs::Color_Name(base_color).c_str());
-        return;
-        break;
-    }
-    std::size_t color_pos;
-    while((color_pos = new_sdf.find(old_color)) != std::string::npos){
-      new_sdf = new_sdf.erase(color_pos, old_color.length()).insert(color_pos, new_color);
-      color_pos = new_sdf.find(old_color);
-    }
-    std::string plugin_string = "<plugin name=\"Puck\" filename=\"libpuck.so\"/>";
-    std::size_t string_pos = new_sdf.find(plugin_string);
-    new_sdf = new_sdf.erase(string_pos, plugin_string.length())
-              .insert(string_pos, "<plugin name=\"Puck\" filename=\"libpuck.so\"><baseColor>" + color_string + "</baseColor></plugin>");
-
-  }
-  else{
-    printf("Cant find workpiece_base sdf file:%s", sdf_path.c_str());
-    return;
-  }
-    
-
-  new_puck_msg.set_sdf(new_sdf.c_str());
-  new_puck_msg.set_clone_model_name(new_name.c_str());
-#if GAZEBO_MAJOR_VERSION > 5
-  msgs::Set(new_puck_msg.mutable_pose(), spawn_pose.Ign());
-#else
-  msgs::Set(new_puck_msg.mutable_pose(), spawn_pose);
-#endif
-  factoryPub->Publish(new_puck_msg);
+  pool_->spawn_puck(spawn_pose, base_color);
 }
 
 math::Pose Mps::get_puck_world_pose(double long_side, double short_side, double height)
 {
   if(height == -1.0)
     height = BELT_HEIGHT;
-  double mps_x = this->model_->GetWorldPose().pos.x;
-  double mps_y = this->model_->GetWorldPose().pos.y;
-  double mps_ori = this->model_->GetWorldPose().rot.GetAsEuler().z;
-  double x = mps_x
-             + (BELT_OFFSET_SIDE + long_side)  * cos(mps_ori)
-             - ((BELT_LENGTH + short_side) / 2 - PUCK_SIZE) * sin(mps_ori);
-  double y = mps_y
-             + (BELT_OFFSET_SIDE + long_side)  * sin(mps_ori)
-             + ((BELT_LENGTH + short_side) / 2 - PUCK_SIZE) * cos(mps_ori);
+  double x = mps_pose_.pos.x
+             + (BELT_OFFSET_SIDE + long_side)  * mps_cos_
+             - ((BELT_LENGTH + short_side) / 2 - PUCK_SIZE) * mps_sin_;
+  double y = mps_pose_.pos.y
+             + (BELT_OFFSET_SIDE + long_side)  * mps_sin_
+             + ((BELT_LENGTH + short_side) / 2 - PUCK_SIZE) * mps_cos_;
   return math::Pose(x,y,height,0,0,0);
 }
 
 void Mps::on_joint_msg(ConstJointPtr &joint_msg)
 {
   hold_pucks[joint_msg->id()] = joint_msg->child();
+  replay_pending_ = true;
   //printf("%s got joint command on joint %i with child %s\n", name_.c_str(), joint_msg->id(), joint_msg->child().c_str());
 }
 
@@ -34,7 +34,10 @@
 #include <llsf_msgs/MachineCommands.pb.h>
 #include <gazsim_msgs/NewPuck.pb.h>
 #include <map>
+#include <atomic>
 #include <configurable/configurable.h>
+#include "workpiece_tracker.h"
+#include "workpiece_pool.h"
 
 //amount of pucks to listen for
 #define NUMBER_PUCKS number_pucks_
@@ -75,7 +78,7 @@ namespace gazebo
    * Plugin to control a simulated MPS
    * @author Frederik Zwilling
    */
-  class Mps: public gazebo_rcll::ConfigurableAspect
+  class Mps: public gazebo_rcll::ConfigurableAspect, public WorkpieceRegionListener
   {
   public:
     Mps(physics::ModelPtr _parent, sdf::ElementPtr /*_sdf*/);
@@ -84,6 +87,11 @@ namespace gazebo
     virtual void OnUpdate(const common::UpdateInfo &);
     virtual void Reset();
 
+    virtual void workpiece_entered(unsigned int region, const std::string &puck_name,
+                                   const math::Pose &pose);
+    virtual void workpiece_left(unsigned int region, const std::string &puck_name,
+                                const math::Pose &pose);
+
   protected:
     static const std::map<std::string,std::string> name_id_match;
 
@@ -99,8 +107,20 @@ namespace gazebo
 
     // Mps Stuff:
     
-    /// Subscriber to get puck positions
-    std::vector<transport::SubscriberPtr> puck_subs_;
+    /// Tracker reporting pucks entering or leaving the regions of the mps
+    WorkpieceTracker *tracker_;
+    unsigned int input_region_;
+    unsigned int output_region_;
+    /// pose of the mps the cached geometry was computed for
+    math::Pose mps_pose_;
+    /// recompute the cached geometry and move the regions after the mps was repositioned
+    virtual void update_geometry();
+    void compute_belt_geometry();
+    /// hand the pucks in the regions to on_puck_msg again
+    void replay_pucks_in_regions();
+    /// set by the transport callbacks, the replay runs in the next OnUpdate
+    std::atomic<bool> replay_pending_;
+    void deliver_puck_pose(const std::string &puck_name, const math::Pose &pose);
     /// Subscriber to get machine infos
     transport::SubscriberPtr machine_info_subscriber_;
 
@@ -148,9 +168,11 @@ namespace gazebo
     physics::WorldPtr world_;
     
     void spawn_puck(const math::Pose &spawn_pose, enum gazsim_msgs::Color base_color);
+    /// Pool providing the workpieces to spawn
+    WorkpiecePool *pool_;
+    /// Index to look up workpiece models by name
+    gazebo_rcll::WorkpieceRegistry *registry_;
     
-    // Create a publisher on the ~/factory topic
-    transport::PublisherPtr factoryPub;
     
     /// Publisher for puck command
     transport::PublisherPtr puck_cmd_pub_;
@@ -168,6 +190,12 @@ namespace gazebo
     gazebo::physics::JointPtr tag_joint_output;
     bool grabbed_tags_ = false;
 
+    //cached belt geometry, valid for mps_pose_
+    double mps_cos_;
+    double mps_sin_;
+    math::Pose input_pose_;
+    math::Pose output_pose_;
+
     //config values:
     int number_pucks_;
     //how far is the center of the belt hsifted from the machine center
@@ -0,0 +1,153 @@
+/***************************************************************************
+ *  qa_workpiece_pool.cpp - QA for reusing workpieces from the pool
+ *
+ *  Created: Sat Oct 17 11:47:42 2026
+ *  Copyright  2026  agent
+ *
+ ****************************************************************************/
+
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.GPL file in the doc directory.
+ */
+
+// Do not mention in API doc
+/// @cond QA
+
+// Needs GAZEBO_RCLL and a GAZEBO_PLUGIN_PATH containing libpuck.so, like
+// the simulation itself. Spawns workpieces through the pool and checks
+// that every reused workpiece is announced on ~/new_puck again, since the
+// stations only learn about workpieces from these announcements.
+
+#include "../workpiece_pool.h"
+
+#include <boost/thread/mutex.hpp>
+#include <gazebo/gazebo.hh>
+#include <cstdio>
+#include <map>
+#include <string>
+
+using namespace gazebo;
+
+static boost::mutex announce_mutex;
+static std::map<std::string, unsigned int> announcements;
+
+static void
+on_new_puck(ConstNewPuckPtr &msg)
+{
+  boost::mutex::scoped_lock lock(announce_mutex);
+  announcements[msg->puck_name()]++;
+}
+
+static unsigned int
+num_announcements(const std::string &name)
+{
+  boost::mutex::scoped_lock lock(announce_mutex);
+  std::map<std::string, unsigned int>::iterator it = announcements.find(name);
+  return it == announcements.end() ? 0 : it->second;
+}
+
+//pool workpiece announced more than once, empty if there is none
+static std::string
+reannounced_pool_puck(const std::map<std::string, unsigned int> &before)
+{
+  boost::mutex::scoped_lock lock(announce_mutex);
+  for(const auto &a : announcements)
+  {
+    if(a.first.compare(0, 10, "puck_pool_") != 0)
+      continue;
+    std::map<std::string, unsigned int>::const_iterator b = before.find(a.first);
+    if(a.second > (b == before.end() ? 0 : b->second))
+      return a.first;
+  }
+  return "";
+}
+
+static std::map<std::string, unsigned int>
+snapshot()
+{
+  boost::mutex::scoped_lock lock(announce_mutex);
+  return announcements;
+}
+
+int
+main(int argc, char **argv)
+{
+  if(!gazebo::setupServer(argc, argv))
+  {
+    printf("Failed to set up gazebo server\n");
+    return 1;
+  }
+  physics::WorldPtr world = gazebo::loadWorld("worlds/empty.world");
+  if(!world)
+  {
+    printf("Failed to load empty world\n");
+    gazebo::shutdown();
+    return 1;
+  }
+
+  transport::NodePtr node(new transport::Node());
+  node->Init(world->GetName());
+  transport::SubscriberPtr sub = node->Subscribe("~/new_puck", &on_new_puck);
+
+  WorkpiecePool::init(world);
+  WorkpiecePool *pool = WorkpiecePool::get_pool();
+  //let the pool workpieces load and announce themselves
+  gazebo::runWorld(world, 1000);
+
+  int rv = 0;
+  math::Pose spawn_pose(0., 0., 0.05, 0., 0., 0.);
+
+  std::map<std::string, unsigned int> before = snapshot();
+  pool->spawn_puck(spawn_pose, gazsim_msgs::Color::BLACK);
+  gazebo::runWorld(world, 100);
+  std::string name = reannounced_pool_puck(before);
+  if(name.empty())
+  {
+    printf("FAILED: first spawn did not re-announce a pool workpiece\n");
+    rv = 1;
+  }
+  else
+  {
+    printf("First spawn reused %s, announced %u times\n",
+           name.c_str(), num_announcements(name));
+
+    //return it and spawn until the same workpiece is claimed again,
+    //the pool hands out the longest parked workpiece first
+    unsigned int count = num_announcements(name);
+    pool->release_puck(name);
+    gazebo::runWorld(world, 100);
+    unsigned int spawns = 0;
+    while(num_announcements(name) == count && spawns++ < snapshot().size())
+    {
+      pool->spawn_puck(spawn_pose, gazsim_msgs::Color::SILVER);
+      gazebo::runWorld(world, 100);
+    }
+    if(num_announcements(name) != count + 1)
+    {
+      printf("FAILED: %s was not announced again after %u more spawns\n",
+             name.c_str(), spawns);
+      rv = 1;
+    }
+    else
+    {
+      printf("Second spawn of %s announced it again (%u times)\n",
+             name.c_str(), num_announcements(name));
+    }
+  }
+
+  sub.reset();
+  node->Fini();
+  gazebo::shutdown();
+  return rv;
+}
+
+/// @endcond
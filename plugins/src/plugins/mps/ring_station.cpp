@@ -29,6 +29,15 @@ RingStation::RingStation(physics::ModelPtr _parent, sdf::ElementPtr  _sdf) :
 {
   add_base_publisher_ = node_->Advertise<llsf_msgs::MachineAddBase>(TOPIC_MACHINE_ADD_BASE);
   number_bases_ = 0;
+  add_base_pose_ = get_puck_world_pose(-0.25,0);
+  add_base_region_ = tracker_->add_region(this, add_base_pose(), 0.1);
+}
+
+void RingStation::update_geometry()
+{
+  Mps::update_geometry();
+  add_base_pose_ = get_puck_world_pose(-0.25,0);
+  tracker_->move_region(add_base_region_, add_base_pose());
 }
 
 void RingStation::on_puck_msg(ConstPosePtr &msg)
@@ -37,7 +46,7 @@ void RingStation::on_puck_msg(ConstPosePtr &msg)
      !is_puck_hold(msg->name()))
   {
     add_base();
-    world_->GetEntity(msg->name())->SetWorldPose(get_puck_world_pose(-0.2,-0.5));
+    registry_->get(msg->name())->SetWorldPose(get_puck_world_pose(-0.2,-0.5));
   }
   //check if the puck is in the input area
   if(puck_in_input(msg) &&
@@ -103,7 +112,7 @@ void RingStation::new_machine_info(ConstMachine &machine)
   {
     printf("%s is putting a %s ring onto %s\n", name_.c_str(), gazsim_msgs::Color_Name(color_to_put_).c_str(), puck_in_processing_name_.c_str());
     //teleport puck to output
-    model_->GetWorld()->GetEntity(puck_in_processing_name_)->SetWorldPose(math::Pose(output_x(), output_y(), BELT_HEIGHT, 0, 0, 0));
+    registry_->get(puck_in_processing_name_)->SetWorldPose(math::Pose(output_x(), output_y(), BELT_HEIGHT, 0, 0, 0));
     //spawn a ring ontop of the puck
     //write to the puck plugin
     if(!puck_cmd_pub_->HasConnections())
@@ -141,5 +150,5 @@ void RingStation::add_base()
 
 math::Pose RingStation::add_base_pose()
 {
-  return get_puck_world_pose(-0.25,0);
+  return add_base_pose_;
 }
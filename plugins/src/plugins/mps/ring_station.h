@@ -44,6 +44,9 @@ public:
   
   void add_base();
   math::Pose add_base_pose();
+  unsigned int add_base_region_;
+  math::Pose add_base_pose_;
+  void update_geometry();
   u_int32_t number_bases_;
   
   gazebo::transport::PublisherPtr add_base_publisher_;
@@ -0,0 +1,307 @@
+/***************************************************************************
+ *  workpiece_pool.cpp - Pool of workpiece models reused for spawning
+ *
+ *  Created: Sat Oct 17 11:47:42 2026
+ *  Copyright  2026  agent
+ ****************************************************************************/
+
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.GPL file in the doc directory.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <stdlib.h>
+
+#include "workpiece_pool.h"
+#include <utils/misc/string_template.h>
+
+using namespace gazebo;
+
+/// @cond INTERNALS
+/** Parsed workpiece_base sdf shared by all spawns, read once from disk */
+struct WorkpieceSdfTemplate
+{
+  WorkpieceSdfTemplate()
+  {
+    std::string sdf_path = getenv("GAZEBO_RCLL");
+    sdf_path += "/models/workpiece_base/model.sdf";
+    std::ifstream raw_sdf_file(sdf_path.c_str());
+    valid = raw_sdf_file.is_open();
+    if(!valid){
+      printf("Cant find workpiece_base sdf file:%s", sdf_path.c_str());
+      return;
+    }
+    sdf = fawkes::StringTemplate(std::string((std::istreambuf_iterator<char>(raw_sdf_file)),
+                                             std::istreambuf_iterator<char>()));
+    name_slot = sdf.add_placeholder("workpiece_base", /* first only */ true);
+    color_slot = sdf.add_placeholder("1.0 0.35 0.0 1");
+    plugin_slot = sdf.add_placeholder("<plugin name=\"Puck\" filename=\"libpuck.so\"/>", true);
+    valid = sdf.num_occurrences(name_slot) > 0 && sdf.num_occurrences(plugin_slot) > 0;
+  }
+
+  bool valid;
+  fawkes::StringTemplate sdf;
+  unsigned int name_slot;
+  unsigned int color_slot;
+  unsigned int plugin_slot;
+};
+
+static const WorkpieceSdfTemplate &
+workpiece_sdf_template()
+{
+  static WorkpieceSdfTemplate sdf_template;
+  return sdf_template;
+}
+/// @endcond
+
+WorkpiecePool* WorkpiecePool::pool_ = NULL;
+
+/** Constructor (Singleton)
+ * @param world World the workpieces live in
+ */
+WorkpiecePool::WorkpiecePool(physics::WorldPtr world)
+{
+  world_ = world;
+  registry_ = gazebo_rcll::WorkpieceRegistry::get_registry();
+  created_pucks_ = 0;
+
+  pool_size_ = config->get_uint("plugins/mps/pool_size");
+  pool_parking_x_ = config->get_float("plugins/mps/pool_parking_x");
+  pool_parking_y_ = config->get_float("plugins/mps/pool_parking_y");
+  topic_puck_release_ = config->get_string("plugins/mps/topic_puck_release");
+  topic_puck_command_ = config->get_string("plugins/mps/topic_puck_command");
+
+  //the namespace is set to the world name!
+  node_ = transport::NodePtr(new transport::Node());
+  node_->Init(world_->GetName());
+
+  factory_pub_ = node_->Advertise<msgs::Factory>("~/factory");
+  puck_cmd_pub_ = node_->Advertise<gazsim_msgs::WorkpieceCommand>(topic_puck_command_);
+  new_puck_pub_ = node_->Advertise<gazsim_msgs::NewPuck>("~/new_puck");
+  new_puck_sub_ = node_->Subscribe("~/new_puck", &WorkpiecePool::on_new_puck, this);
+  release_sub_ = node_->Subscribe(TOPIC_PUCK_RELEASE, &WorkpiecePool::on_release_msg, this);
+
+  update_connection_ = event::Events::ConnectWorldUpdateBegin(boost::bind(&WorkpiecePool::on_update, this, _1));
+
+  //fill the pool, the workpieces become available once they announced themselves
+  for(unsigned int i = 0; i < POOL_SIZE; i++)
+  {
+    std::string name = "puck_pool_" + std::to_string(i);
+    pending_.insert(name);
+    create_puck(name, parking_pose(name), gazsim_msgs::Color::RED);
+  }
+}
+
+WorkpiecePool::~WorkpiecePool()
+{
+}
+
+/** Initialization of the pool, does nothing if it already exists
+ * @param world World the workpieces live in
+ */
+void WorkpiecePool::init(physics::WorldPtr world)
+{
+  if(!pool_)
+  {
+    pool_ = new WorkpiecePool(world);
+  }
+}
+
+/** Getter for Singleton
+ * @return pointer to singleton, NULL before init()
+ */
+WorkpiecePool* WorkpiecePool::get_pool()
+{
+  return pool_;
+}
+
+/** Spawn a workpiece base
+ * Claims a parked workpiece if there is one, otherwise a new model is created.
+ * A claimed workpiece is moved in the next world update, so this may be
+ * called from any thread.
+ * @param spawn_pose world pose to spawn the workpiece at
+ * @param base_color color of the base
+ */
+void WorkpiecePool::spawn_puck(const math::Pose &spawn_pose, gazsim_msgs::Color base_color)
+{
+  {
+    boost::mutex::scoped_lock lock(mutex_);
+    if(!free_.empty())
+    {
+      Claim claim;
+      claim.name = free_.front();
+      claim.pose = spawn_pose;
+      claim.base_color = base_color;
+      free_.pop_front();
+      claims_.push_back(claim);
+      return;
+    }
+  }
+  create_puck(registry_->next_name(), spawn_pose, base_color);
+}
+
+/** Teleport a claimed workpiece to its spawn pose and reset it
+ * Has to be called from the world update thread.
+ * @param claim the claimed workpiece
+ */
+void WorkpiecePool::apply_claim(const Claim &claim)
+{
+  physics::ModelPtr model = registry_->get(claim.name);
+  if(!model)
+  {
+    //the parked model vanished, spawn a new one instead
+    create_puck(registry_->next_name(), claim.pose, claim.base_color);
+    return;
+  }
+
+  model->ResetPhysicsStates();
+  model->SetWorldPose(claim.pose);
+
+  gazsim_msgs::WorkpieceCommand cmd;
+  cmd.set_command(gazsim_msgs::Command::RESET);
+  cmd.set_color(claim.base_color);
+  cmd.set_puck_name(claim.name);
+  puck_cmd_pub_->Publish(cmd);
+
+  //the stations only learn about a workpiece from its announcement,
+  //so announce the reused one like a freshly created workpiece
+  gazsim_msgs::NewPuck new_puck_msg;
+  new_puck_msg.set_puck_name(claim.name);
+  new_puck_msg.set_gps_topic("~/" + claim.name + "/gazsim/gps/");
+  new_puck_pub_->Publish(new_puck_msg);
+}
+
+/** Return a workpiece to the pool
+ * @param puck_name name of the workpiece
+ * @param delay seconds of simulation time before the workpiece is parked
+ */
+void WorkpiecePool::release_puck(const std::string &puck_name, double delay)
+{
+  boost::mutex::scoped_lock lock(mutex_);
+  releases_.push_back(std::make_pair(world_->GetSimTime().Double() + delay, puck_name));
+}
+
+void WorkpiecePool::on_release_msg(ConstReleasePuckPtr &msg)
+{
+  release_puck(msg->puck_name(), msg->has_delay() ? msg->delay() : 0.);
+}
+
+void WorkpiecePool::on_new_puck(ConstNewPuckPtr &msg)
+{
+  boost::mutex::scoped_lock lock(mutex_);
+  if(pending_.erase(msg->puck_name()))
+  {
+    free_.push_back(msg->puck_name());
+  }
+}
+
+void WorkpiecePool::on_update(const common::UpdateInfo & /*info*/)
+{
+  boost::mutex::scoped_lock lock(mutex_);
+  for(const Claim &claim : claims_)
+  {
+    apply_claim(claim);
+  }
+  claims_.clear();
+  if(releases_.empty())
+    return;
+
+  double time = world_->GetSimTime().Double();
+  std::list<std::pair<double, std::string> >::iterator it = releases_.begin();
+  while(it != releases_.end())
+  {
+    if(it->first > time)
+    {
+      ++it;
+      continue;
+    }
+    const std::string &name = it->second;
+    physics::ModelPtr model = registry_->get(name);
+    if(model && std::find(free_.begin(), free_.end(), name) == free_.end())
+    {
+      model->ResetPhysicsStates();
+      model->SetWorldPose(parking_pose(name));
+      free_.push_back(name);
+    }
+    it = releases_.erase(it);
+  }
+}
+
+/** Get the parking pose of a workpiece, assigns a free slot on first use
+ * @param puck_name name of the workpiece
+ * @return world pose off-field
+ */
+math::Pose WorkpiecePool::parking_pose(const std::string &puck_name)
+{
+  std::map<std::string, unsigned int>::iterator it = parking_slots_.find(puck_name);
+  unsigned int slot;
+  if(it == parking_slots_.end())
+  {
+    slot = parking_slots_.size();
+    parking_slots_[puck_name] = slot;
+  }
+  else
+  {
+    slot = it->second;
+  }
+  return math::Pose(POOL_PARKING_X + (slot % 10) * 0.1,
+                    POOL_PARKING_Y + (slot / 10) * 0.1,
+                    0.05, 0, 0, 0);
+}
+
+void WorkpiecePool::create_puck(const std::string &name, const math::Pose &spawn_pose,
+                                gazsim_msgs::Color base_color)
+{
+  printf("creating workpiece %s\n", name.c_str());
+  msgs::Factory new_puck_msg;
+
+  //use the cached workpiece_base sdf and replace the model name
+  const WorkpieceSdfTemplate &sdf_template = workpiece_sdf_template();
+  if(!sdf_template.valid){
+    return;
+  }
+  std::string new_color;
+  std::string color_string;
+  switch (base_color) {
+    case gazsim_msgs::Color::RED:
+      new_color = "1.0 0.0 0.0 1";
+      color_string = "RED";
+      break;
+    case gazsim_msgs::Color::BLACK:
+      new_color = "0.2 0.2 0.2 1";
+      color_string = "BLACK";
+      break;
+    case gazsim_msgs::Color::SILVER:
+      new_color = "0.8 0.8 0.8 1";
+      color_string = "SILVER";
+      break;
+    default:
+      printf("%s should spawn with an unsupported base color %s\n",name.c_str(), gazsim_msgs::Color_Name(base_color).c_str());
+      return;
+      break;
+  }
+  std::vector<std::string> values(3);
+  values[sdf_template.name_slot] = name;
+  values[sdf_template.color_slot] = new_color;
+  values[sdf_template.plugin_slot] = "<plugin name=\"Puck\" filename=\"libpuck.so\"><baseColor>" + color_string + "</baseColor></plugin>";
+
+  new_puck_msg.set_sdf(sdf_template.sdf.fill(values));
+  new_puck_msg.set_clone_model_name(name.c_str());
+#if GAZEBO_MAJOR_VERSION > 5
+  msgs::Set(new_puck_msg.mutable_pose(), spawn_pose.Ign());
+#else
+  msgs::Set(new_puck_msg.mutable_pose(), spawn_pose);
+#endif
+  factory_pub_->Publish(new_puck_msg);
+  created_pucks_++;
+}
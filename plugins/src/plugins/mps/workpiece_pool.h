@@ -0,0 +1,125 @@
+/***************************************************************************
+ *  workpiece_pool.h - Pool of workpiece models reused for spawning
+ *
+ *  Created: Sat Oct 17 11:47:42 2026
+ *  Copyright  2026  agent
+ ****************************************************************************/
+
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.GPL file in the doc directory.
+ */
+
+#ifndef WORKPIECE_POOL_H
+#define WORKPIECE_POOL_H
+
+#include <boost/bind.hpp>
+#include <boost/thread/mutex.hpp>
+#include <gazebo/gazebo.hh>
+#include <gazebo/physics/physics.hh>
+#include <gazebo/common/common.hh>
+#include <gazebo/transport/transport.hh>
+#include <gazsim_msgs/NewPuck.pb.h>
+#include <gazsim_msgs/ReleasePuck.pb.h>
+#include <gazsim_msgs/WorkpieceCommand.pb.h>
+#include <configurable/configurable.h>
+#include <workpieces/workpiece_registry.h>
+#include <deque>
+#include <list>
+#include <map>
+#include <set>
+#include <string>
+
+//number of workpieces kept ready off-field
+#define POOL_SIZE pool_size_
+//where the pooled workpieces are parked
+#define POOL_PARKING_X pool_parking_x_
+#define POOL_PARKING_Y pool_parking_y_
+#define TOPIC_PUCK_RELEASE topic_puck_release_
+
+typedef const boost::shared_ptr<gazsim_msgs::ReleasePuck const> ConstReleasePuckPtr;
+
+namespace gazebo
+{
+  /**
+   * Pool of workpiece models parked off-field. Spawning claims a parked
+   * workpiece, which is reset and teleported to the spawn pose in the
+   * next world update. Only if the pool is empty a new model is created.
+   * Delivered workpieces are returned to the pool. A reused workpiece is
+   * announced on ~/new_puck again, like a freshly created one announces
+   * itself.
+   * @author agent
+   */
+  class WorkpiecePool : public gazebo_rcll::ConfigurableAspect
+  {
+  public:
+    static void init(physics::WorldPtr world);
+    static WorkpiecePool* get_pool();
+
+    void spawn_puck(const math::Pose &spawn_pose, gazsim_msgs::Color base_color);
+    void release_puck(const std::string &puck_name, double delay = 0.);
+
+  private:
+    WorkpiecePool(physics::WorldPtr world);
+    ~WorkpiecePool();
+
+    static WorkpiecePool *pool_;
+
+    /// workpiece claimed from the pool and the pose to spawn it at
+    struct Claim
+    {
+      std::string name;
+      math::Pose pose;
+      gazsim_msgs::Color base_color;
+    };
+
+    void on_update(const common::UpdateInfo &info);
+    void apply_claim(const Claim &claim);
+    void on_new_puck(ConstNewPuckPtr &msg);
+    void on_release_msg(ConstReleasePuckPtr &msg);
+
+    void create_puck(const std::string &name, const math::Pose &spawn_pose,
+                     gazsim_msgs::Color base_color);
+    math::Pose parking_pose(const std::string &puck_name);
+
+    physics::WorldPtr world_;
+    gazebo_rcll::WorkpieceRegistry *registry_;
+    transport::NodePtr node_;
+    event::ConnectionPtr update_connection_;
+    transport::PublisherPtr factory_pub_;
+    transport::PublisherPtr puck_cmd_pub_;
+    transport::PublisherPtr new_puck_pub_;
+    transport::SubscriberPtr new_puck_sub_;
+    transport::SubscriberPtr release_sub_;
+
+    boost::mutex mutex_;
+    /// parked workpieces ready to be claimed
+    std::deque<std::string> free_;
+    /// workpieces which were created for the pool but not announced yet
+    std::set<std::string> pending_;
+    /// workpieces to park as soon as their release time is reached
+    std::list<std::pair<double, std::string> > releases_;
+    /// claimed workpieces to move to their spawn pose in the next update
+    std::list<Claim> claims_;
+    /// parking slot of each workpiece that ever was in the pool
+    std::map<std::string, unsigned int> parking_slots_;
+    unsigned int created_pucks_;
+
+    //config values:
+    unsigned int pool_size_;
+    double pool_parking_x_;
+    double pool_parking_y_;
+    std::string topic_puck_release_;
+    std::string topic_puck_command_;
+  };
+}
+
+#endif // WORKPIECE_POOL_H
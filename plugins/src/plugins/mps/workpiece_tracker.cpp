@@ -0,0 +1,307 @@
+/***************************************************************************
+ *  workpiece_tracker.cpp - World level tracker of workpiece positions
+ *
+ *  Created: Sat Oct 17 11:41:36 2026
+ *  Copyright  2026  agent
+ ****************************************************************************/
+
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.GPL file in the doc directory.
+ */
+
+#include "workpiece_tracker.h"
+
+#include <algorithm>
+#include <iterator>
+
+using namespace gazebo;
+
+WorkpieceTracker* WorkpieceTracker::tracker_ = NULL;
+
+/** Constructor (Singleton)
+ * @param world World the workpieces live in
+ */
+WorkpieceTracker::WorkpieceTracker(physics::WorldPtr world)
+  : grid_(config->get_float("plugins/mps/tracker_grid_cell_size"))
+{
+  world_ = world;
+
+  tracker_interval_ = config->get_float("plugins/mps/tracker_interval");
+  tracker_move_threshold_ = config->get_float("plugins/mps/tracker_move_threshold");
+  topic_puck_poses_ = config->get_string("plugins/mps/topic_puck_poses");
+
+  regions_changed_ = false;
+  last_update_ = world_->GetSimTime().Double();
+
+  //the namespace is set to the world name!
+  node_ = transport::NodePtr(new transport::Node());
+  node_->Init(world_->GetName());
+
+  new_puck_sub_ = node_->Subscribe("~/new_puck", &WorkpieceTracker::on_new_puck, this);
+  request_sub_ = node_->Subscribe("~/request", &WorkpieceTracker::on_request_msg, this);
+  poses_pub_ = node_->Advertise<msgs::Pose_V>(TOPIC_PUCK_POSES);
+
+  update_connection_ = event::Events::ConnectWorldUpdateBegin(boost::bind(&WorkpieceTracker::on_update, this, _1));
+}
+
+WorkpieceTracker::~WorkpieceTracker()
+{
+}
+
+/** Initialization of the tracker, does nothing if it already exists
+ * @param world World the workpieces live in
+ */
+void WorkpieceTracker::init(physics::WorldPtr world)
+{
+  if(!tracker_)
+  {
+    tracker_ = new WorkpieceTracker(world);
+  }
+}
+
+/** Getter for Singleton
+ * @return pointer to singleton, NULL before init()
+ */
+WorkpieceTracker* WorkpieceTracker::get_tracker()
+{
+  return tracker_;
+}
+
+/** Register a spherical region of interest
+ * @param listener listener notified about workpieces entering or leaving
+ * @param center world pose of the region center
+ * @param radius radius of the region
+ * @return id of the region
+ */
+unsigned int WorkpieceTracker::add_region(WorkpieceRegionListener *listener,
+                                          const math::Pose &center, double radius)
+{
+  boost::mutex::scoped_lock lock(mutex_);
+  Region region;
+  region.listener = listener;
+  region.active = true;
+  regions_.push_back(region);
+  grid_.add_zone(center.pos.x, center.pos.y, center.pos.z, radius);
+  regions_changed_ = true;
+  return regions_.size() - 1;
+}
+
+/** Move a region, e.g. because its machine was repositioned
+ * @param region id of the region
+ * @param center new world pose of the region center
+ */
+void WorkpieceTracker::move_region(unsigned int region, const math::Pose &center)
+{
+  boost::mutex::scoped_lock lock(mutex_);
+  if(region < regions_.size())
+  {
+    grid_.move_zone(region, center.pos.x, center.pos.y, center.pos.z);
+    regions_changed_ = true;
+  }
+}
+
+/** Remove all regions of a listener
+ * @param listener listener to remove
+ */
+void WorkpieceTracker::remove_regions(WorkpieceRegionListener *listener)
+{
+  boost::mutex::scoped_lock lock(mutex_);
+  for(unsigned int i = 0; i < regions_.size(); i++)
+  {
+    Region &region = regions_[i];
+    if(region.listener == listener)
+    {
+      for(const std::string &name : region.inside)
+      {
+        std::vector<unsigned int> &in = workpieces_[name].regions;
+        in.erase(std::remove(in.begin(), in.end(), i), in.end());
+      }
+      region.active = false;
+      region.listener = NULL;
+      region.inside.clear();
+      grid_.remove_zone(i);
+    }
+  }
+}
+
+/** Get the workpieces currently inside any region of a listener
+ * @param listener listener whose regions are checked
+ * @return last reported world poses by workpiece name
+ */
+std::map<std::string, math::Pose>
+WorkpieceTracker::workpieces_in_regions(WorkpieceRegionListener *listener)
+{
+  boost::mutex::scoped_lock lock(mutex_);
+  std::map<std::string, math::Pose> result;
+  for(const Region &region : regions_)
+  {
+    if(region.listener != listener)
+      continue;
+    for(const std::string &name : region.inside)
+    {
+      result[name] = workpieces_[name].pose;
+    }
+  }
+  return result;
+}
+
+void WorkpieceTracker::on_new_puck(ConstNewPuckPtr &msg)
+{
+  //the model is looked up in the next update to stay in the physics thread
+  boost::mutex::scoped_lock lock(mutex_);
+  new_pucks_.push_back(msg->puck_name());
+}
+
+void WorkpieceTracker::on_request_msg(ConstRequestPtr &msg)
+{
+  if(msg->request() != "entity_delete")
+  {
+    return;
+  }
+  boost::mutex::scoped_lock lock(mutex_);
+  deleted_pucks_.push_back(msg->data());
+}
+
+/** Stop tracking a workpiece, its regions are told that it left them
+ * @param name name of the workpiece
+ * @param events notifications to deliver after releasing the lock
+ */
+void WorkpieceTracker::drop_workpiece(const std::string &name, std::vector<Event> &events)
+{
+  std::map<std::string, Workpiece>::iterator wp = workpieces_.find(name);
+  if(wp == workpieces_.end())
+  {
+    return;
+  }
+  for(unsigned int i : wp->second.regions)
+  {
+    Region &region = regions_[i];
+    region.inside.erase(name);
+    Event event;
+    event.listener = region.listener;
+    event.region = i;
+    event.puck_name = name;
+    event.pose = wp->second.pose;
+    event.entered = false;
+    events.push_back(event);
+  }
+  workpieces_.erase(wp);
+}
+
+void WorkpieceTracker::on_update(const common::UpdateInfo & /*info*/)
+{
+  double time = world_->GetSimTime().Double();
+  if(time - last_update_ < TRACKER_INTERVAL)
+  {
+    return;
+  }
+  last_update_ = time;
+
+  std::vector<Event> events;
+  msgs::Pose_V poses_msg;
+  {
+    boost::mutex::scoped_lock lock(mutex_);
+    gazebo_rcll::WorkpieceRegistry *registry = gazebo_rcll::WorkpieceRegistry::get_registry();
+
+    //forget deleted workpieces, including those removed without a delete request
+    for(const auto &entry : workpieces_)
+    {
+      if(!registry->get(entry.first))
+      {
+        deleted_pucks_.push_back(entry.first);
+      }
+    }
+    for(const std::string &name : deleted_pucks_)
+    {
+      drop_workpiece(name, events);
+    }
+    deleted_pucks_.clear();
+
+    for(const std::string &name : new_pucks_)
+    {
+      physics::ModelPtr model = registry->get(name);
+      if(model)
+      {
+        Workpiece &wp = workpieces_[name];
+        wp.model = model;
+        wp.reported = false;
+      }
+    }
+    new_pucks_.clear();
+
+    bool reclassify = regions_changed_;
+    std::vector<unsigned int> hits;
+    regions_changed_ = false;
+
+    for(auto &entry : workpieces_)
+    {
+      const std::string &name = entry.first;
+      Workpiece &wp = entry.second;
+      math::Pose pose = wp.model->GetWorldPose();
+      bool moved = !wp.reported || pose.pos.Distance(wp.pose.pos) > TRACKER_MOVE_THRESHOLD;
+      if(!moved && !reclassify)
+        continue;
+      if(moved)
+      {
+        wp.pose = pose;
+        wp.reported = true;
+        msgs::Pose *pose_msg = poses_msg.add_pose();
+#if GAZEBO_MAJOR_VERSION > 5
+        msgs::Set(pose_msg, pose.Ign());
+#else
+        msgs::Set(pose_msg, pose);
+#endif
+        pose_msg->set_name(name);
+      }
+
+      //look up the regions containing the workpiece, only changes are reported
+      grid_.find(wp.pose.pos.x, wp.pose.pos.y, wp.pose.pos.z, hits);
+      if(hits == wp.regions)
+        continue;
+      std::vector<unsigned int> changed;
+      std::set_symmetric_difference(hits.begin(), hits.end(),
+                                    wp.regions.begin(), wp.regions.end(),
+                                    std::back_inserter(changed));
+      for(unsigned int i : changed)
+      {
+        Region &region = regions_[i];
+        bool in = std::binary_search(hits.begin(), hits.end(), i);
+        if(in)
+          region.inside.insert(name);
+        else
+          region.inside.erase(name);
+        Event event;
+        event.listener = region.listener;
+        event.region = i;
+        event.puck_name = name;
+        event.pose = wp.pose;
+        event.entered = in;
+        events.push_back(event);
+      }
+      wp.regions.swap(hits);
+    }
+  }
+
+  if(poses_msg.pose_size() > 0 && poses_pub_->HasConnections())
+  {
+    poses_pub_->Publish(poses_msg);
+  }
+
+  //listeners may call back into the tracker, so the lock is released here
+  for(const Event &event : events)
+  {
+    if(event.entered)
+      event.listener->workpiece_entered(event.region, event.puck_name, event.pose);
+    else
+      event.listener->workpiece_left(event.region, event.puck_name, event.pose);
+  }
+}
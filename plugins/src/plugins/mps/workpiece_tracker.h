@@ -0,0 +1,154 @@
+/***************************************************************************
+ *  workpiece_tracker.h - World level tracker of workpiece positions
+ *
+ *  Created: Sat Oct 17 11:41:36 2026
+ *  Copyright  2026  agent
+ ****************************************************************************/
+
+/*  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  Read the full text in the LICENSE.GPL file in the doc directory.
+ */
+
+#ifndef WORKPIECE_TRACKER_H
+#define WORKPIECE_TRACKER_H
+
+#include <boost/bind.hpp>
+#include <boost/thread/mutex.hpp>
+#include <gazebo/gazebo.hh>
+#include <gazebo/physics/physics.hh>
+#include <gazebo/common/common.hh>
+#include <gazebo/transport/transport.hh>
+#include <gazsim_msgs/NewPuck.pb.h>
+#include <configurable/configurable.h>
+#include <workpieces/workpiece_registry.h>
+#include <utils/geometry/zone_grid.h>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+//interval in which the workpiece positions are checked
+#define TRACKER_INTERVAL tracker_interval_
+//distance a workpiece has to move before it is reported again
+#define TRACKER_MOVE_THRESHOLD tracker_move_threshold_
+#define TOPIC_PUCK_POSES topic_puck_poses_
+
+namespace gazebo
+{
+  /**
+   * Interface for classes interested in workpieces entering or leaving
+   * regions registered at the WorkpieceTracker
+   * @author agent
+   */
+  class WorkpieceRegionListener
+  {
+  public:
+    virtual ~WorkpieceRegionListener() {}
+
+    /** A workpiece entered a region of this listener
+     * @param region id of the region
+     * @param puck_name name of the workpiece
+     * @param pose world pose of the workpiece
+     */
+    virtual void workpiece_entered(unsigned int region, const std::string &puck_name,
+                                   const math::Pose &pose) = 0;
+    /** A workpiece left a region of this listener
+     * @param region id of the region
+     * @param puck_name name of the workpiece
+     * @param pose world pose of the workpiece
+     */
+    virtual void workpiece_left(unsigned int region, const std::string &puck_name,
+                                const math::Pose &pose) = 0;
+  };
+
+  /**
+   * Tracks all workpieces of the world in one place, publishes the poses
+   * of moved workpieces in one batch and notifies listeners about
+   * workpieces entering or leaving their regions
+   * @author agent
+   */
+  class WorkpieceTracker : public gazebo_rcll::ConfigurableAspect
+  {
+  public:
+    static void init(physics::WorldPtr world);
+    static WorkpieceTracker* get_tracker();
+
+    unsigned int add_region(WorkpieceRegionListener *listener,
+                            const math::Pose &center, double radius);
+    void move_region(unsigned int region, const math::Pose &center);
+    void remove_regions(WorkpieceRegionListener *listener);
+    std::map<std::string, math::Pose> workpieces_in_regions(WorkpieceRegionListener *listener);
+
+  private:
+    WorkpieceTracker(physics::WorldPtr world);
+    ~WorkpieceTracker();
+
+    static WorkpieceTracker *tracker_;
+
+    void on_update(const common::UpdateInfo &info);
+    void on_new_puck(ConstNewPuckPtr &msg);
+    void on_request_msg(ConstRequestPtr &msg);
+
+    /// region of interest of one listener, indexed like the zones of grid_
+    struct Region
+    {
+      WorkpieceRegionListener *listener;
+      bool active;
+      std::set<std::string> inside;
+    };
+
+    /// last reported state of one workpiece
+    struct Workpiece
+    {
+      physics::ModelPtr model;
+      math::Pose pose;
+      bool reported;
+      /// sorted ids of the regions the workpiece is in
+      std::vector<unsigned int> regions;
+    };
+
+    /// pending notification, delivered without holding the lock
+    struct Event
+    {
+      WorkpieceRegionListener *listener;
+      unsigned int region;
+      std::string puck_name;
+      math::Pose pose;
+      bool entered;
+    };
+
+    physics::WorldPtr world_;
+    transport::NodePtr node_;
+    event::ConnectionPtr update_connection_;
+    transport::SubscriberPtr new_puck_sub_;
+    transport::SubscriberPtr request_sub_;
+    transport::PublisherPtr poses_pub_;
+
+    boost::mutex mutex_;
+    std::vector<Region> regions_;
+    fawkes::ZoneGrid grid_;
+    std::map<std::string, Workpiece> workpieces_;
+    std::vector<std::string> new_pucks_;
+    std::vector<std::string> deleted_pucks_;
+    bool regions_changed_;
+    double last_update_;
+
+    //config values:
+    double tracker_interval_;
+    double tracker_move_threshold_;
+    std::string topic_puck_poses_;
+
+    void drop_workpiece(const std::string &name, std::vector<Event> &events);
+  };
+}
+
+#endif // WORKPIECE_TRACKER_H
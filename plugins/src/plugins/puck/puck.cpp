@@ -29,14 +29,71 @@ using namespace gazebo;
 // Register this plugin to make it available in the simulator
 GZ_REGISTER_MODEL_PLUGIN(Puck)
 
+PuckCommandDispatcher* PuckCommandDispatcher::dispatcher_ = NULL;
+
+PuckCommandDispatcher::PuckCommandDispatcher(physics::WorldPtr world)
+{
+  // the namespace is set to the world name!
+  node_ = transport::NodePtr(new transport::Node());
+  node_->Init(world->GetName());
+  command_subscriber_ = node_->Subscribe(std::string("~/pucks/cmd"), &PuckCommandDispatcher::on_command_msg, this);
+}
+
+/** Register a puck for commands addressed to it
+ * @param puck_name name the commands are addressed to
+ * @param puck puck plugin handling the commands
+ * @param world world the puck lives in
+ */
+void PuckCommandDispatcher::add_puck(const std::string &puck_name, Puck *puck, physics::WorldPtr world)
+{
+  if(!dispatcher_)
+  {
+    dispatcher_ = new PuckCommandDispatcher(world);
+  }
+  boost::mutex::scoped_lock lock(dispatcher_->mutex_);
+  dispatcher_->pucks_[puck_name] = puck;
+}
+
+/** Unregister a puck
+ * @param puck_name name the puck was registered with
+ * @param puck puck plugin to unregister
+ */
+void PuckCommandDispatcher::remove_puck(const std::string &puck_name, Puck *puck)
+{
+  if(!dispatcher_)
+    return;
+  boost::mutex::scoped_lock lock(dispatcher_->mutex_);
+  std::unordered_map<std::string, Puck *>::iterator it = dispatcher_->pucks_.find(puck_name);
+  if(it != dispatcher_->pucks_.end() && it->second == puck)
+  {
+    dispatcher_->pucks_.erase(it);
+  }
+}
+
+void PuckCommandDispatcher::on_command_msg(ConstWorkpieceCommandPtr &cmd)
+{
+  // the lock is held while handling, so the puck can't be destructed meanwhile
+  boost::mutex::scoped_lock lock(mutex_);
+  std::unordered_map<std::string, Puck *>::iterator it = pucks_.find(cmd->puck_name());
+  if(it != pucks_.end())
+  {
+    it->second->on_command_msg(cmd);
+  }
+}
+
 ///Constructor
 Puck::Puck()
+  : ring_height_(config, "plugins/puck/ring_height"),
+    cap_height_(config, "plugins/puck/cap_height"),
+    workpiece_height_(config, "plugins/puck/workpiece_height")
 {
 }
 ///Destructor
 Puck::~Puck()
 {
   printf("Destructing Puck Plugin for %s!\n",this->name().c_str());
+  PuckCommandDispatcher::remove_puck(registered_name_, this);
+  gazebo_rcll::WorkpieceRegistry::get_registry()->remove(registered_name_);
 }
 
 inline std::string Puck::name()
@@ -72,8 +129,10 @@ void Puck::Load(physics::ModelPtr _parent, sdf::ElementPtr _sdf)
   
   this->new_puck_publisher = this->node_->Advertise<gazsim_msgs::NewPuck>("~/new_puck");
   
-  // subscribe for puck commands
-  this->command_subscriber = this->node_->Subscribe(std::string("~/pucks/cmd"), &Puck::on_command_msg, this);
+  // commands addressed to this puck are routed by the dispatcher
+  this->registered_name_ = name();
+  PuckCommandDispatcher::add_puck(registered_name_, this, model_->GetWorld());
+  gazebo_rcll::WorkpieceRegistry::get_registry()->add(model_);
   
   // publisher for workpiece command results
   this->workpiece_result_pub_ = node_->Advertise<gazsim_msgs::WorkpieceResult>("~/pucks/cmd/result");
@@ -125,10 +184,7 @@ void Puck::Reset()
  */ 
 void Puck::on_command_msg(ConstWorkpieceCommandPtr &cmd)
 {
-  if(cmd->puck_name() != name())
-  {
-    return;
-  }
+  requester_ = cmd->has_requester() ? cmd->requester() : "";
   printf("puck %s recieved command: ",this->name().c_str());
   switch(cmd->command())
   {
@@ -152,12 +208,16 @@ void Puck::on_command_msg(ConstWorkpieceCommandPtr &cmd)
 	gazsim_msgs::WorkpieceResult msg;
 	msg.set_puck_name(name());
 	msg.set_color(gazsim_msgs::Color::NONE);
-	this->workpiece_result_pub_->Publish(msg);
+	send_result(requester_, msg);
       }      
       break;
     case gazsim_msgs::Command::DELIVER:
       deliver(cmd->team_color());
       break;
+    case gazsim_msgs::Command::RESET:
+      printf("reset with base color: %s\n",gazsim_msgs::Color_Name(cmd->color()).c_str());
+      reset(cmd->color());
+      break;
     default:
       printf("unknowen");
       break;
@@ -198,10 +258,74 @@ void Puck::remove_cap()
   gazsim_msgs::WorkpieceResult msg;
   msg.set_puck_name(name());
   msg.set_color(cap_color_);
-  this->workpiece_result_pub_->Publish(msg);
+  send_result(requester_, msg);
   have_cap = false;
 }
 
+void Puck::reset(gazsim_msgs::Color base_color)
+{
+  if(have_cap)
+  {
+    msgs::Visual vis_msg = create_visual_msg("cap", CAP_HEIGHT, gazsim_msgs::Color::RED);
+    vis_msg.set_visible(false);
+    visual_pub_->Publish(vis_msg);
+    have_cap = false;
+  }
+  for(size_t i = 0; i < ring_count_; i++)
+  {
+    msgs::Visual vis_msg;
+    vis_msg.set_parent_name(name() + "::cylinder");
+    vis_msg.set_name(name() + "::cylinder::ring_" + std::to_string(i));
+    vis_msg.set_visible(false);
+    visual_pub_->Publish(vis_msg);
+  }
+  ring_count_ = 0;
+  ring_colors_.clear();
+  cap_color_ = gazsim_msgs::Color::NONE;
+
+  base_color_ = base_color;
+  common::Color color;
+  switch(base_color)
+  {
+    case gazsim_msgs::Color::BLACK:
+      color = common::Color(0.2, 0.2, 0.2);
+      break;
+    case gazsim_msgs::Color::SILVER:
+      color = common::Color(0.8, 0.8, 0.8);
+      break;
+    case gazsim_msgs::Color::RED:
+    default:
+      color = common::Color(1, 0, 0);
+      break;
+  }
+  msgs::Visual base_msg;
+  base_msg.set_parent_name(name() + "::cylinder");
+  base_msg.set_name(name() + "::cylinder::cylinder_visual");
+  msgs::Set(base_msg.mutable_material()->mutable_diffuse(), color);
+  msgs::Set(base_msg.mutable_material()->mutable_ambient(), color);
+  visual_pub_->Publish(base_msg);
+}
+
+/** Send a command result
+ * @param requester station which sent the command, empty if unknown
+ * @param result result to send
+ */
+void Puck::send_result(const std::string &requester, gazsim_msgs::WorkpieceResult &result)
+{
+  if(requester.empty())
+  {
+    workpiece_result_pub_->Publish(result);
+    return;
+  }
+  result.set_requester(requester);
+  transport::PublisherPtr &pub = requester_result_pubs_[requester];
+  if(!pub)
+  {
+    pub = node_->Advertise<gazsim_msgs::WorkpieceResult>("~/pucks/cmd/result/" + requester);
+  }
+  pub->Publish(result);
+}
+
 
 msgs::Visual Puck::create_visual_msg(std::string element_name, double element_height, gazsim_msgs::Color clr)
 {
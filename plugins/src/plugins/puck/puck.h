@@ -24,26 +24,56 @@
 #include <gazebo/common/common.hh>
 #include <stdio.h>
 #include <gazebo/transport/transport.hh>
+#include <map>
 #include <stack>
+#include <unordered_map>
+#include <boost/thread/mutex.hpp>
 #include <string.h>
 #include <gazsim_msgs/WorkpieceCommand.pb.h>
 #include <llsf_msgs/OrderInfo.pb.h>
 #include <configurable/configurable.h>
+#include <workpieces/workpiece_registry.h>
 
 
 typedef const boost::shared_ptr<llsf_msgs::SetOrderDeliveredByColor const> ConstSetOrderDeliveredByColorPtr;
 typedef const boost::shared_ptr<gazsim_msgs::WorkpieceCommand const> ConstWorkpieceCommandPtr;
 
 /// The height of one ring
-#define RING_HEIGHT config->get_float("plugins/puck/ring_height")
+#define RING_HEIGHT ring_height_.get()
 /// The height of one cap
-#define CAP_HEIGHT config->get_float("plugins/puck/cap_height")
+#define CAP_HEIGHT cap_height_.get()
 /// The height of the workpiece base
-#define WORKPIECE_HEIGHT config->get_float("plugins/puck/workpiece_height")
+#define WORKPIECE_HEIGHT workpiece_height_.get()
 #define TOPIC_SET_ORDER_DELIVERY_BY_COLOR config->get_string("plugins/puck/topic_set_order_delivery_by_color").c_str()
 
 namespace gazebo
 {
+  class Puck;
+
+  /**
+   * Single subscriber of the workpiece command topic routing each
+   * command to the addressed puck, so a command is deserialized once
+   * instead of once per workpiece in the world
+   * @author agent
+   */
+  class PuckCommandDispatcher
+  {
+  public:
+    static void add_puck(const std::string &puck_name, Puck *puck, physics::WorldPtr world);
+    static void remove_puck(const std::string &puck_name, Puck *puck);
+
+  private:
+    PuckCommandDispatcher(physics::WorldPtr world);
+    void on_command_msg(ConstWorkpieceCommandPtr &cmd);
+
+    static PuckCommandDispatcher *dispatcher_;
+
+    transport::NodePtr node_;
+    transport::SubscriberPtr command_subscriber_;
+    boost::mutex mutex_;
+    std::unordered_map<std::string, Puck *> pucks_;
+  };
+
   /**
    * Plugin to control a simulated Puck
    * @author Randolph Maaßen
@@ -59,6 +89,9 @@ namespace gazebo
     virtual void OnUpdate(const common::UpdateInfo &);
     virtual void Reset();
 
+    /// Handler for command messages addressed to this puck
+    void on_command_msg(ConstWorkpieceCommandPtr &cmd);
+
   private:
     /// Pointer to the gazbeo model
     physics::ModelPtr model_;
@@ -74,18 +107,18 @@ namespace gazebo
     
     // Puck Stuff:
     
-    /// Subscriber to get commands for model ring addition
-    transport::SubscriberPtr command_subscriber;
+    /// Name the puck is registered with at the command dispatcher
+    std::string registered_name_;
     
     transport::PublisherPtr new_puck_publisher;
 
-    /// Handler for command messages
-    void on_command_msg(ConstWorkpieceCommandPtr &cmd);
     /// Add one ring on command
     void add_ring(gazsim_msgs::Color clr);
     /// Add a cap on command
     void add_cap(gazsim_msgs::Color clr);
     void remove_cap();
+    /// Remove rings and cap and recolor the base, used when reused from the pool
+    void reset(gazsim_msgs::Color base_color);
 
     /// The number of stored rings
     size_t ring_count_;
@@ -103,12 +136,22 @@ namespace gazebo
     /// Publisher to send visual changes to gazebo
     transport::PublisherPtr visual_pub_;
     
-    /// Publisher to send command results
+    /// Publisher to send command results of commands without requester
     transport::PublisherPtr workpiece_result_pub_;
+    /// Publishers to send command results to the requesting station
+    std::map<std::string, transport::PublisherPtr> requester_result_pubs_;
+    void send_result(const std::string &requester, gazsim_msgs::WorkpieceResult &result);
+    /// Requester of the command currently handled
+    std::string requester_;
     
     msgs::Visual create_visual_msg(std::string element_name, double element_height, gazsim_msgs::Color clr);
     
     void deliver(gazsim_msgs::Team team);
     transport::PublisherPtr delivery_pub_;
+
+    //config values
+    gazebo_rcll::ConfigValueHandle<float> ring_height_;
+    gazebo_rcll::ConfigValueHandle<float> cap_height_;
+    gazebo_rcll::ConfigValueHandle<float> workpiece_height_;
   };
 }
@@ -30,6 +30,11 @@ GZ_REGISTER_MODEL_PLUGIN(TagVision)
 
 ///Constructor
 TagVision::TagVision()
+  : send_interval_(config, "plugins/tag-vision/send_interval"),
+    tag_pose_refresh_interval_(config, "plugins/tag-vision/tag_pose_refresh_interval"),
+    max_view_distance_(config, "plugins/tag-vision/max_view_distance"),
+    camera_fov_(config, "plugins/tag-vision/camera_fov"),
+    tag_grid_(max_view_distance_.get())
 {
 }
 ///Destructor
@@ -87,10 +92,14 @@ void TagVision::Load(physics::ModelPtr _parent, sdf::ElementPtr /*_sdf*/)
 
   //init last sent time
   last_sent_time_ = model_->GetWorld()->GetSimTime().Double();
-  last_searched_for_new_tags_time_ = model_->GetWorld()->GetSimTime().Double();
+  last_tag_pose_refresh_time_ = model_->GetWorld()->GetSimTime().Double();
 
   //create publisher
   result_pub_ = this->node_->Advertise<msgs::PosesStamped>(TAG_VISION_RESULT_TOPIC);
+
+  //tags spawned later are announced as new models
+  searched_for_tags_ = false;
+  model_info_sub_ = world_node_->Subscribe("~/model/info", &TagVision::on_model_info_msg, this);
   
   link_pose_ = model_->GetWorldPose();
 }
@@ -102,25 +111,29 @@ void TagVision::OnUpdate(const common::UpdateInfo & /*_info*/)
 {
   double time = model_->GetWorld()->GetSimTime().Double();
 
-  if(time - last_searched_for_new_tags_time_ > SEARCH_FOR_TAGS_INTERVAL)
+  if(!searched_for_tags_)
   {
-    last_searched_for_new_tags_time_ = time;
-    //check if there are new tags
+    //tags which already existed when the plugin was loaded
+    searched_for_tags_ = true;
     unsigned int modelCount = model_->GetWorld()->GetModelCount();
-    physics::ModelPtr tmp;
     for(unsigned int i = 0 ; i < modelCount; i++)
     {
-      tmp = model_->GetWorld()->GetModel(i);
-      if (fnmatch("*tag_*",tmp->GetName().c_str(),FNM_CASEFOLD) == 0)
-      {
-	//add tag if not already added
-	if(tag_poses_.find(tmp) == tag_poses_.end())
-	{
-	  // printf("TagVision: found new tag: %s\n", tmp->GetName().c_str());
-	  tag_poses_[tmp] = tmp->GetWorldPose();
-	}
-      }
+      add_tag(model_->GetWorld()->GetModel(i));
+    }
+  }
+  {
+    boost::mutex::scoped_lock lock(new_tags_mutex_);
+    for(const std::string &name : new_tags_)
+    {
+      add_tag(model_->GetWorld()->GetModel(name));
     }
+    new_tags_.clear();
+  }
+
+  if(time - last_tag_pose_refresh_time_ > TAG_POSE_REFRESH_INTERVAL)
+  {
+    last_tag_pose_refresh_time_ = time;
+    refresh_tag_poses();
   }
 
   link_pose_ = link_->GetWorldPose();
@@ -130,15 +143,15 @@ void TagVision::OnUpdate(const common::UpdateInfo & /*_info*/)
     //compute tag-vision result
     msgs::PosesStamped res;
     msgs::Stamp(res.mutable_time());
-    for (std::map<physics::ModelPtr, math::Pose>::iterator it=tag_poses_.begin(); it!=tag_poses_.end(); it++)
+    //only tags in view distance are checked
+    std::vector<unsigned int> in_range;
+    tag_grid_.find(link_pose_.pos.x, link_pose_.pos.y, link_pose_.pos.z, in_range);
+    for(unsigned int i : in_range)
     {
-      it->second = it->first->GetWorldPose();
-      math::Pose rel_pos = it->second - link_pose_;
-      math::Pose rel_pos_normalized(rel_pos);
-      rel_pos_normalized.pos.Normalize();
-      //check if tag is in range, in the camera field of view and faced to the robot
-      if(rel_pos.pos.GetLength() < MAX_VIEW_DISTANCE
-	 && rel_pos.pos.x > 0 && std::abs(std::asin(rel_pos_normalized.pos.y)) < CAMERA_FOV / 2.0
+      const Tag &tag = tags_[i];
+      math::Pose rel_pos = tag.pose - link_pose_;
+      //check if tag is in the camera field of view and faced to the robot
+      if(rel_pos.pos.x > 0 && std::abs(std::asin(rel_pos.pos.y / rel_pos.pos.GetLength())) < CAMERA_FOV / 2.0
 	 && std::abs(rel_pos.rot.GetYaw()) > 1.57)
       {
 	//add tag to result
@@ -148,8 +161,8 @@ void TagVision::OnUpdate(const common::UpdateInfo & /*_info*/)
 #else
 	*tag_pose = msgs::Convert(rel_pos);
 #endif
-	tag_pose->set_name(it->first->GetName());
-	tag_pose->set_id(get_tag_id_from_name(it->first->GetName()));
+	tag_pose->set_name(tag.name);
+	tag_pose->set_id(tag.id);
       }
     }
     result_pub_->Publish(res);
@@ -163,6 +176,52 @@ void TagVision::Reset()
 }
 
 
+void TagVision::on_model_info_msg(ConstModelPtr &msg)
+{
+  //the model is looked up in the next update to stay in the physics thread
+  if(fnmatch("*tag_*", msg->name().c_str(), FNM_CASEFOLD) == 0)
+  {
+    boost::mutex::scoped_lock lock(new_tags_mutex_);
+    new_tags_.push_back(msg->name());
+  }
+}
+
+/** Add a tag model to the known tags
+ * @param model model which is added if it is a tag and not known yet
+ */
+void TagVision::add_tag(physics::ModelPtr model)
+{
+  if(!model || fnmatch("*tag_*", model->GetName().c_str(), FNM_CASEFOLD) != 0
+     || !tag_names_.insert(model->GetName()).second)
+  {
+    return;
+  }
+  // printf("TagVision: found new tag: %s\n", model->GetName().c_str());
+  Tag tag;
+  tag.model = model;
+  tag.pose = model->GetWorldPose();
+  tag.name = model->GetName();
+  tag.id = get_tag_id_from_name(tag.name);
+  tags_.push_back(tag);
+  tag_grid_.add_zone(tag.pose.pos.x, tag.pose.pos.y, tag.pose.pos.z, MAX_VIEW_DISTANCE);
+}
+
+/** Look up the poses of all known tags again
+ */
+void TagVision::refresh_tag_poses()
+{
+  for(unsigned int i = 0; i < tags_.size(); i++)
+  {
+    Tag &tag = tags_[i];
+    math::Pose pose = tag.model->GetWorldPose();
+    if(pose != tag.pose)
+    {
+      tag.pose = pose;
+      tag_grid_.move_zone(i, pose.pos.x, pose.pos.y, pose.pos.z);
+    }
+  }
+}
+
 /** Extract the tag-id from the model name of the tag
  * @param name model-name of the tag
  */ 
@@ -24,19 +24,24 @@
 #include <gazebo/common/common.hh>
 #include <stdio.h>
 #include <gazebo/transport/transport.hh>
+#include <boost/thread/mutex.hpp>
 #include <list>
 #include <map>
+#include <set>
 #include <string>
+#include <vector>
 #include <llsf_msgs/MachineInfo.pb.h>
 #include <configurable/configurable.h>
+#include <utils/geometry/zone_grid.h>
 
 //config values
 #define TOPIC_TAG_SUFFIX config->get_string("plugins/tag-vision/topic_tag_suffix").c_str()
 #define TAG_VISION_RESULT_TOPIC config->get_string("plugins/tag-vision/tag_vision_result_topic").c_str()
-#define SEND_INTERVAL config->get_float("plugins/tag-vision/send_interval")
-#define SEARCH_FOR_TAGS_INTERVAL config->get_int("plugins/tag-vision/search_for_tags_interval")
-#define MAX_VIEW_DISTANCE config->get_int("plugins/tag-vision/max_view_distance")
-#define CAMERA_FOV config->get_float("plugins/tag-vision/camera_fov")
+#define SEND_INTERVAL send_interval_.get()
+//tags are attached to the static mps, their poses are only looked up again in this interval
+#define TAG_POSE_REFRESH_INTERVAL tag_pose_refresh_interval_.get()
+#define MAX_VIEW_DISTANCE max_view_distance_.get()
+#define CAMERA_FOV camera_fov_.get()
 
 namespace gazebo
 {
@@ -69,7 +74,7 @@ namespace gazebo
 
     ///time variable to send in intervals
     double last_sent_time_;
-    double last_searched_for_new_tags_time_;
+    double last_tag_pose_refresh_time_;
 
     //robot position
     math::Pose link_pose_;
@@ -77,11 +82,38 @@ namespace gazebo
     /// Pointer to the link where the camera should be
     physics::LinkPtr link_;
 
-    ///Subscriber to get tag-positions
-    std::map<physics::ModelPtr, math::Pose> tag_poses_;
+    /// known tag with its cached pose
+    struct Tag
+    {
+      physics::ModelPtr model;
+      math::Pose pose;
+      std::string name;
+      int id;
+    };
+    ///all known tags, indexed like the zones of tag_grid_
+    std::vector<Tag> tags_;
+    std::set<std::string> tag_names_;
+    ///Subscriber to get notified about new models
+    transport::SubscriberPtr model_info_sub_;
+    ///names of new tag models, added in the next update
+    std::vector<std::string> new_tags_;
+    boost::mutex new_tags_mutex_;
+    bool searched_for_tags_;
     ///Publisher for Detected tags
     transport::PublisherPtr result_pub_;
 
+    void on_model_info_msg(ConstModelPtr &msg);
+    void add_tag(physics::ModelPtr model);
+    void refresh_tag_poses();
     int get_tag_id_from_name(std::string name);
+
+    //config values
+    gazebo_rcll::ConfigValueHandle<float> send_interval_;
+    gazebo_rcll::ConfigValueHandle<float> tag_pose_refresh_interval_;
+    gazebo_rcll::ConfigValueHandle<int> max_view_distance_;
+    gazebo_rcll::ConfigValueHandle<float> camera_fov_;
+
+    ///zone of view distance around each tag, to find the tags in range of the camera
+    fawkes::ZoneGrid tag_grid_;
   };
 }